@@ -7,6 +7,7 @@
 #include <climits>
 
 #include "../inputGenerator.hpp"
+#include "../src/gzip_writer.hpp"
 
 using namespace std::chrono;
 
@@ -68,6 +69,13 @@ void testGeneratingGraphs() {
         auto graph = inputGenerator::chain(1000000);
     };
 
+    inputGenerator::Graph<> reusedGraph;
+    auto reusedChainGraphTest = [&reusedGraph]() {
+        reusedGraph.reset(1000000);
+        for (int i = 1; i < 1000000; ++i)
+            inputGenerator::addEdge(reusedGraph[i - 1], reusedGraph[i]);
+    };
+
     auto pathGraphTest = []() {
         auto graph = inputGenerator::path(1000000);
     };
@@ -76,18 +84,202 @@ void testGeneratingGraphs() {
         auto graph = inputGenerator::tree(1000000);
     };
 
+    auto streamedTreeGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::tree(1000000, [&sum](int from, int to) {
+            sum += from ^ to;
+        });
+    };
+
+    auto recursiveTreeGraphTest = []() {
+        auto graph = inputGenerator::recursiveTree(1000000);
+    };
+
+    auto streamedHugeTreeTest = []() {
+        int64_t sum = 0;
+        inputGenerator::tree(10000000, [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+    auto streamedHugeRecursiveTreeTest = []() {
+        int64_t sum = 0;
+        inputGenerator::recursiveTree(10000000, [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+    auto streamedTreeFamiliesTest = []() {
+        int64_t sum = 0;
+        auto add = [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        };
+        inputGenerator::caterpillar(10000000, 1000, add);
+        inputGenerator::broom(10000000, 1000, add);
+        inputGenerator::karyTree(10000000, 3, inputGenerator::Boolean::True, add);
+        inputGenerator::boundedDegreeTree(10000000, 3, add);
+        inputGenerator::heightTree(10000000, 1000, inputGenerator::Boolean::True, add);
+    };
+
+    auto walkedTree = inputGenerator::tree(1000000);
+    volatile int64_t walkedSum = 0;
+    auto walkedTreeEdgesTest = [&walkedTree, &walkedSum]() {
+        int64_t sum = 0;
+        for (auto &edge : walkedTree.edgeRange())
+            sum += edge.fromIndex() ^ edge.toIndex();
+        walkedSum = sum;
+    };
+
+    auto writtenTreeTest = [&walkedTree]() {
+        inputGenerator::Writer writer("/dev/null");
+        inputGenerator::writeEdgeList(writer, walkedTree);
+    };
+
+    auto parallelTreeTest = [&walkedTree]() {
+        inputGenerator::ThreadPool pool;
+        inputGenerator::Writer writer("/dev/null");
+        inputGenerator::writeEdgeList(writer, walkedTree, pool);
+    };
+
+    auto weightedTreeTest = [&walkedTree]() {
+        inputGenerator::Writer writer("/dev/null");
+        inputGenerator::writeEdgeList(
+            writer, walkedTree,
+            inputGenerator::distinctEdgeWeights(walkedTree, 1, 1000000000));
+    };
+
+    auto gzippedTreeTest = [&walkedTree]() {
+        inputGenerator::GzipWriter writer("/tmp/inputGenerator_benchmark.gz");
+        inputGenerator::writeEdgeList(writer, walkedTree);
+    };
+
+    auto mappedTreeTest = [&walkedTree]() {
+        inputGenerator::mapEdgeList("/tmp/inputGenerator_benchmark.txt",
+                                    walkedTree);
+        std::remove("/tmp/inputGenerator_benchmark.txt");
+    };
+
     auto wideTreeGraphTest = []() {
         auto graph = inputGenerator::wideTree(1000000, 30000);
     };
 
+    auto streamedExactWideTreeTest = []() {
+        int64_t sum = 0;
+        inputGenerator::exactWideTree(10000000, 1000, 3,
+                                      inputGenerator::Boolean::True,
+                                      [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
     auto undirectedGraphTest = []() {
             auto graph = inputGenerator::undirectedGraph(100000, 500000);
     };
 
+    auto streamedUndirectedGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::undirectedGraph(1000000, 10000000,
+                                        [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+    {
+        inputGenerator::Writer writer("/tmp/inputGenerator_benchmark_graph.txt");
+        writer << 1000000 << ' ' << 10000000 << '\n';
+        inputGenerator::undirectedGraph(1000000, 10000000, std::ref(writer));
+    }
+    auto validatedUndirectedGraphTest = []() {
+        inputGenerator::Validator validator(
+            std::string("/tmp/inputGenerator_benchmark_graph.txt"));
+        auto header = validator.readLine(2, 1, 10000000);
+        auto graph = validator.readEdges(header[0], header[1], 0);
+        validator.readEnd();
+        validator.expect(graph.simple(), "the graph is not simple");
+    };
+
+    auto streamedBinomialGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::binomialGraph(10000000, 2e-7,
+                                      [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+    auto streamedParallelGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::ThreadPool pool;
+        inputGenerator::undirectedGraph(10000000, 10000000, pool,
+                                        [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
     auto undirectedConnectedGraphTest = []() {
         auto graph = inputGenerator::undirectedGraph(100000, 500000, inputGenerator::Boolean::True);
     };
 
+    auto streamedConnectedGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::undirectedGraph(10000000, 20000000,
+                                        inputGenerator::Boolean::True,
+                                        [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+
+    auto streamedDagTest = []() {
+        int64_t sum = 0;
+        inputGenerator::longPathDag(1000000, 10000000, 1000000,
+                                    [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+    auto streamedComponentGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::componentGraph(1000000, 1000, 10000000,
+                                       [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+    auto streamedRegularGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::regularGraph(1000000, 10,
+                                     [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+    auto streamedPowerLawGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::degreeSequenceGraph(
+            inputGenerator::powerLawDegrees(1000000, 2.5, 1, 1000),
+            [&sum](int64_t from, int64_t to) {
+                sum += from ^ to;
+            });
+    };
+
+    auto streamedGeometricGraphTest = []() {
+        int64_t sum = 0;
+        inputGenerator::geometricGraph(1000000, 0.00178, 2,
+                                       inputGenerator::GeometricComponents::kAll,
+                                       0.0, 1.0,
+                                       [&sum](int64_t from, int64_t to) {
+            sum += from ^ to;
+        });
+    };
+
+    auto mazeTest = [](const inputGenerator::MazeAlgorithm &algorithm) {
+        auto maze = inputGenerator::mazeMatrix(5000, 5000, algorithm);
+    };
+
+    auto obstacleGridTest = []() {
+        auto grid = inputGenerator::obstacleGrid(10000, 10000, 0.3, {0, 0},
+                                                 {9999, 9999});
+    };
 
     auto bipartiteGraphTest = []() {
         auto graph = inputGenerator::bipartite(500000, 500000, 1000000);
@@ -97,6 +289,14 @@ void testGeneratingGraphs() {
         auto graph = inputGenerator::regularBipartite(nodes, degree);
     };
 
+    auto streamedRegularBipartiteTest = []() {
+        int64_t sum = 0;
+        inputGenerator::regularBipartite(1000000, 10,
+                                         [&sum](int64_t left, int64_t right) {
+            sum += left ^ right;
+        });
+    };
+
     std::cout << "For graph generation there will be some time between tests to have consistency (FIXME: find out why I need to do this)!" << std::endl;
 
     pause();
@@ -105,21 +305,102 @@ void testGeneratingGraphs() {
     pause();
     std::cout << "Generating a 1 million node chain takes " << time_taken(chainGraphTest) << std::endl;
 
+    reusedChainGraphTest();
+    pause();
+    std::cout << "Rebuilding a 1 million node chain in a reused graph takes " << time_taken(reusedChainGraphTest) << std::endl;
+
     pause();
     std::cout << "Generating a 1 million node path takes " << time_taken(pathGraphTest) << std::endl;
 
     pause();
     std::cout << "Generating a 1 million node tree takes " << time_taken(treeGraphTest) << std::endl;
 
+    pause();
+    pause();
+    std::cout << "Generating a 1 million node random recursive tree takes " << time_taken(recursiveTreeGraphTest) << std::endl;
+
+    std::cout << "Streaming a 1 million node tree to a callback takes " << time_taken(streamedTreeGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 10 million node tree to a callback takes " << time_taken(streamedHugeTreeTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 10 million node random recursive tree to a callback takes " << time_taken(streamedHugeRecursiveTreeTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 10 million node caterpillar, broom, 3-ary tree, degree 3 tree and height 1000 tree to a callback takes " << time_taken(streamedTreeFamiliesTest) << std::endl;
+
+    pause();
+    std::cout << "Going through the edges of a 1 million node tree takes " << time_taken(walkedTreeEdgesTest) << std::endl;
+
+    pause();
+    std::cout << "Writing the edge list of a 1 million node tree takes " << time_taken(writtenTreeTest) << std::endl;
+
+    pause();
+    std::cout << "Writing the edge list of a 1 million node tree to a mapped file takes " << time_taken(mappedTreeTest) << std::endl;
+
+    pause();
+    std::cout << "Writing the edge list of a 1 million node tree on every core takes " << time_taken(parallelTreeTest) << std::endl;
+
+    pause();
+    std::cout << "Giving distinct weights to the edges of a 1 million node tree and writing them takes " << time_taken(weightedTreeTest) << std::endl;
+
+    pause();
+    std::cout << "Writing the gzipped edge list of a 1 million node tree takes " << time_taken(gzippedTreeTest) << std::endl;
+    std::remove("/tmp/inputGenerator_benchmark.gz");
+
     pause();
     std::cout << "Generating a 1 million node wide tree (diameter at least 30.000) takes " << time_taken(wideTreeGraphTest) << std::endl;
 
+    pause();
+    std::cout << "Streaming a 10 million node tree with diameter exactly 1.000 and degree at most 3 to a callback takes " << time_taken(streamedExactWideTreeTest) << std::endl;
+
     pause();
     std::cout << "Generating a 100.000 node graph with 500.000 edges takes " << time_taken(undirectedGraphTest) << std::endl;
 
+    pause();
+    std::cout << "Streaming a 1.000.000 node graph with 10.000.000 edges to a callback takes " << time_taken(streamedUndirectedGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 10.000.000 node G(n, p) graph with about 10.000.000 edges to a callback takes " << time_taken(streamedBinomialGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 10.000.000 node graph with 10.000.000 edges made on every core to a callback takes " << time_taken(streamedParallelGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Validating a 1.000.000 node simple graph with 10.000.000 edges takes " << time_taken(validatedUndirectedGraphTest) << std::endl;
+    std::remove("/tmp/inputGenerator_benchmark_graph.txt");
+
     pause();
     std::cout << "Generating a 100.000 node connected graph with 500.000 edges takes " << time_taken(undirectedConnectedGraphTest) << std::endl;
 
+    pause();
+    std::cout << "Streaming a 10.000.000 node connected graph with 20.000.000 edges to a callback takes " << time_taken(streamedConnectedGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 1.000.000 node DAG with 10.000.000 arcs and a path through every node to a callback takes " << time_taken(streamedDagTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 1.000.000 node directed graph with 1.000 strongly connected components and 10.000.000 arcs to a callback takes " << time_taken(streamedComponentGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 1.000.000 node 10-regular graph to a callback takes " << time_taken(streamedRegularGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 1.000.000 node graph with power law degrees (exponent 2.5, from 1 to 1.000) to a callback takes " << time_taken(streamedPowerLawGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Streaming a 1.000.000 point geometric graph in the unit square with radius 0.00178 (about 5.000.000 edges) to a callback takes " << time_taken(streamedGeometricGraphTest) << std::endl;
+
+    pause();
+    std::cout << "Generating a 10.001 x 10.001 character maze (5.000 x 5.000 rooms) with randomized Kruskal takes " << time_taken(std::bind(mazeTest, inputGenerator::MazeAlgorithm::kKruskal)) << std::endl;
+
+    pause();
+    std::cout << "Generating the same maze with Wilson's algorithm takes " << time_taken(std::bind(mazeTest, inputGenerator::MazeAlgorithm::kWilson)) << std::endl;
+
+    pause();
+    std::cout << "Generating a 10.000 x 10.000 grid with 30% obstacles and opposite corners joined takes " << time_taken(obstacleGridTest) << std::endl;
+
     pause();
     std::cout << "Generating a 1.000.000 node (500.000 left and 500.000 right) bipartite graph with 1.000.000 edges takes " << time_taken(bipartiteGraphTest) << std::endl;
 
@@ -129,6 +410,9 @@ void testGeneratingGraphs() {
     pause();
     std::cout << "Generating a 10.000 node (5.000 left and 5.000 right) regular bipartite graph with degree 100 on each node takes " << time_taken(std::bind(regularBipartiteGraphTest, 5000, 100)) << std::endl;
 
+    pause();
+    std::cout << "Streaming a 2.000.000 node (1.000.000 left and 1.000.000 right) regular bipartite graph with degree 10 on each node to a callback takes " << time_taken(streamedRegularBipartiteTest) << std::endl;
+
     std::cout << std::endl;
 }
 
@@ -65,4 +65,6 @@ int main() {
     cout << "Random bipartite graph with 10 nodes: " << bipartite(10) << endl;
 
     cout << "A 2-regular bipartite graph with 6 nodes: " << regularBipartite(6, 2) << endl;
+
+    cout << "A bipartite graph with degrees 3 2 2 1 on the left and 2 2 2 1 1 on the right: " << degreeSequenceBipartite({3, 2, 2, 1}, {2, 2, 2, 1, 1}) << endl;
 }
@@ -2,6 +2,10 @@
 
 #define INPUT_GENERATOR_DEBUG
 #include "../src/undirected_graph.hpp"
+#include "../src/directed_graph.hpp"
+#include "../src/degree_sequence.hpp"
+#include "../src/geometric.hpp"
+#include "../src/variant.hpp"
 
 using namespace std;
 using namespace inputGenerator;
@@ -52,5 +56,41 @@ int main() {
     graph.mergeGraph(undirectedGraph(3, Boolean::True));
     graph.Index();
     cout << "Random undirected graph with 2 connected components, one with 4 nodes and the other with 3: " << graph << endl;
-}
 
+    cout << endl;
+
+    // the variants share the base graph, only their changes are stored
+    GraphVariant<> base(undirectedGraph(5, 4, Boolean::True));
+    auto variant = base.variant();
+    variant.eraseEdge(*base.base().edgeRange().begin());
+    variant.addEdge(0, 4);
+    variant.swapLabels(0, 1);
+    cout << "A connected graph with 5 nodes and 4 edges: " << base.graph() << endl;
+    cout << "The same with one edge moved and nodes 0 and 1 swapped: " << variant.graph() << endl;
+
+    cout << endl;
+
+    // directed ones print a row for where an arc starts
+    cout << "Random DAG with 6 nodes, 8 arcs and a path through all the nodes: " << longPathDag(6, 8, 6) << endl;
+
+    cout << endl;
+
+    cout << "Random directed graph with 7 nodes, 12 arcs and 3 strongly connected components in a row: " << componentGraph(7, 3, 12) << endl;
+
+    cout << endl;
+
+    cout << "Random 3-regular graph with 8 nodes: " << regularGraph(8, 3) << endl;
+
+    cout << endl;
+
+    cout << "Random graph with 7 nodes and degrees 4 3 3 2 2 1 1: " << degreeSequenceGraph({4, 3, 3, 2, 2, 1, 1}) << endl;
+
+    cout << endl;
+
+    // node i sits at points[i]
+    auto geometric = geometricGraph(6, 3.0, 2, GeometricComponents::kConnected, 0, 9);
+    cout << "Random connected geometric graph on 6 points of a 10 x 10 grid, joining points at most 3 apart:" << endl;
+    for (auto &point : geometric.second)
+        cout << "(" << point[0] << ", " << point[1] << ") ";
+    cout << endl << geometric.first << endl;
+}
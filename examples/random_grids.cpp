@@ -0,0 +1,26 @@
+#include <iostream>
+
+#define INPUT_GENERATOR_DEBUG
+#include "../src/grid.hpp"
+
+using namespace std;
+using namespace inputGenerator;
+
+int main() {
+    cout << "A 4-neighbour grid graph with 2 rows and 3 columns, cell (i, j) is node 3 * i + j:" << endl;
+    gridGraph(2, 3, Boolean::False, [](int64_t from, int64_t to) {
+        cout << from << " " << to << endl;
+    });
+
+    cout << endl;
+
+    cout << "A maze of 4 x 10 rooms (randomized Kruskal):" << endl << mazeMatrix(4, 10) << endl;
+
+    cout << "A maze of 4 x 10 rooms with a fifth of the other walls opened (Wilson):" << endl << mazeMatrix(4, 10, MazeAlgorithm::kWilson, 0.2) << endl;
+
+    auto grid = obstacleGrid(6, 20, 0.4, {0, 0}, {5, 19});
+    cout << "A 6 x 20 grid with 40% obstacles where the corners are always joined:" << endl << grid << endl;
+
+    auto end = cellAtDistance(grid, {0, 0}, 10);
+    cout << "A cell 10 steps away from the top left corner: (" << end.first << ", " << end.second << ")" << endl;
+}
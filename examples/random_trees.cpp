@@ -1,6 +1,9 @@
 #include <iostream>
 
 #include "../src/tree.hpp"
+#include "../src/tree_families.hpp"
+#include "../src/writer.hpp"
+#include "../src/attributes.hpp"
 
 using namespace std;
 using namespace inputGenerator;
@@ -43,12 +46,56 @@ int main() {
 
     cout << endl;
 
+    cout << "Random recursive tree of size 5 (every node hangs from an earlier one): " << recursiveTree(5) << endl;
+
+    cout << endl;
+
+    cout << "Caterpillar of size 7 with a spine of 3 nodes: " << caterpillar(7, 3) << endl;
+
+    cout << endl;
+
+    cout << "Binary tree of size 7 in heap order (node i is under (i - 1) / 2): " << karyTree(7, 2, Boolean::False) << endl;
+
+    cout << endl;
+
+    cout << "Random tree of size 8 with no node of degree more than 3: " << boundedDegreeTree(8, 3) << endl;
+
+    cout << endl;
+
     cout << "Random tree of size 8 but with diameter at least 4: " << wideTree(8, 4) << endl;
 
     cout << endl;
 
+    cout << "Random tree of size 8 with diameter exactly 5 and no node of degree more than 3: " << exactWideTree(8, 5, 3) << endl;
+
+    cout << endl;
+
     auto graph = wideTree(5, 4, Boolean::False);
     graph.Index({{graph[0], 1}, {graph[1], 3}}, 1);
     cout << "Random tree of size 5, diameter at least 4 and the two nodes at least at that distance are 1 and 3 (indexed from 1): " << graph << endl;
+
+    cout << endl;
+
+    cout << "Edges of a random tree of size 6 sent straight to a callback, no graph is built: " << endl;
+    tree(6, [](int from, int to) {
+        cout << from << " " << to << endl;
+    });
+
+    cout << endl;
+
+    cout << "A random tree of size 6 (indexed from 1) as an edge list and as a parent array, written with the buffered writer:" << endl << flush;
+    auto small = tree(6);
+    small.Index(1);
+    {
+        Writer writer;
+        writeEdgeList(writer, small);
+        writeParentArray(writer, small, small[1]);
+    }
+
+    cout << "The same tree with weights from 1 to 9 on its edges:" << endl << flush;
+    {
+        Writer writer;
+        writeEdgeList(writer, small, edgeWeights(small, 1, 9));
+    }
 }
 
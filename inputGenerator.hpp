@@ -8,5 +8,17 @@
 #include "src/graph.hpp"
 #include "src/chain.hpp"
 #include "src/tree.hpp"
+#include "src/tree_families.hpp"
 #include "src/bipartite.hpp"
 #include "src/undirected_graph.hpp"
+#include "src/directed_graph.hpp"
+#include "src/degree_sequence.hpp"
+#include "src/attributes.hpp"
+#include "src/geometric.hpp"
+#include "src/grid.hpp"
+#include "src/variant.hpp"
+#include "src/writer.hpp"
+#include "src/mapped_writer.hpp"
+#include "src/thread_pool.hpp"
+#include "src/parallel_writer.hpp"
+#include "src/validator.hpp"
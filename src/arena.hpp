@@ -0,0 +1,256 @@
+#ifndef INPUT_GENERATOR_ARENA_HPP_
+#define INPUT_GENERATOR_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "handle.hpp"
+
+namespace inputGenerator {
+
+/**
+ * A bump allocator with small size-class free lists
+ * Graphs allocate their nodes, adjacency maps and edge data from one of these
+ * so building a graph doesn't go to malloc for every tiny object and
+ * everything is given back at once when the last user of the arena dies
+ */
+class Arena : public _Counted {
+  public:
+    explicit Arena(const size_t &firstBlock = 4096);
+
+    ~Arena();
+
+    void* allocate(const size_t &bytes,
+                   const size_t &alignment = alignof(std::max_align_t));
+
+    void deallocate(void *pointer, const size_t &bytes);
+
+    // rewinds the arena, the blocks are kept for the next user
+    // only call it when nothing allocated from here is alive anymore
+    void reset();
+
+    // bytes taken from malloc
+    size_t capacity() const {
+        return capacity_;
+    }
+
+  private:
+    Arena(const Arena&);
+
+    void operator=(const Arena&);
+
+    void* allocateSlow(const size_t &bytes, const size_t &alignment);
+
+    struct Block {
+        char *data;
+        size_t size;
+    };
+
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    // everything up to this goes through the free lists
+    static const size_t kSizeClass = 16;
+    static const size_t kMaximumPooled = 512;
+    // we stop doubling the blocks here
+    static const size_t kMaximumBlock = 1 << 24;
+
+    static size_t sizeClass(const size_t &bytes) {
+        return (bytes + kSizeClass - 1) / kSizeClass;
+    }
+
+    std::vector<Block> blocks_;
+    std::vector<FreeNode*> freeLists_;
+
+    // the block we're bumping in and the position inside it
+    size_t current_;
+    char *position_, *end_;
+
+    size_t nextBlock_;
+    size_t capacity_;
+};
+
+const size_t Arena::kSizeClass;
+const size_t Arena::kMaximumPooled;
+const size_t Arena::kMaximumBlock;
+
+Arena::Arena(const size_t &firstBlock):
+        freeLists_(kMaximumPooled / kSizeClass + 1, nullptr),
+        current_(0),
+        position_(nullptr),
+        end_(nullptr),
+        nextBlock_(firstBlock),
+        capacity_(0) {
+}
+
+Arena::~Arena() {
+    for (auto &block : blocks_)
+        std::free(block.data);
+}
+
+void* Arena::allocate(const size_t &bytes, const size_t &alignment) {
+    if (bytes <= kMaximumPooled && alignment <= kSizeClass) {
+        size_t index = sizeClass(bytes);
+        if (freeLists_[index]) {
+            FreeNode *node = freeLists_[index];
+            freeLists_[index] = node->next;
+            return node;
+        }
+
+        // pooled sizes are rounded up so they can be reused by anyone
+        // from the same class
+        size_t rounded = index * kSizeClass;
+        if (rounded == 0)
+            rounded = kSizeClass;
+        if (static_cast<size_t>(end_ - position_) >= rounded &&
+                reinterpret_cast<uintptr_t>(position_) % kSizeClass == 0) {
+            void *result = position_;
+            position_ += rounded;
+            return result;
+        }
+        return allocateSlow(rounded, kSizeClass);
+    }
+
+    return allocateSlow(bytes, alignment);
+}
+
+void* Arena::allocateSlow(const size_t &bytes, const size_t &alignment) {
+    while (true) {
+        if (position_) {
+            uintptr_t address = reinterpret_cast<uintptr_t>(position_);
+            size_t padding = (alignment - address % alignment) % alignment;
+            if (static_cast<size_t>(end_ - position_) >= padding + bytes) {
+                void *result = position_ + padding;
+                position_ += padding + bytes;
+                return result;
+            }
+            ++current_;
+        }
+
+        // after a reset we go through the blocks we already have
+        if (current_ < blocks_.size()) {
+            position_ = blocks_[current_].data;
+            end_ = position_ + blocks_[current_].size;
+            continue;
+        }
+
+        size_t size = nextBlock_;
+        while (size < bytes + alignment)
+            size *= 2;
+        if (nextBlock_ < kMaximumBlock)
+            nextBlock_ *= 2;
+
+        char *data = static_cast<char*>(std::malloc(size));
+        if (!data)
+            throw std::bad_alloc();
+
+        blocks_.push_back({data, size});
+        capacity_ += size;
+        current_ = blocks_.size() - 1;
+        position_ = data;
+        end_ = data + size;
+    }
+}
+
+void Arena::deallocate(void *pointer, const size_t &bytes) {
+    // big chunks are only given back on reset or when the arena dies
+    if (!pointer || bytes > kMaximumPooled)
+        return;
+
+    FreeNode *node = static_cast<FreeNode*>(pointer);
+    size_t index = sizeClass(bytes);
+    node->next = freeLists_[index];
+    freeLists_[index] = node;
+}
+
+void Arena::reset() {
+    for (auto &list : freeLists_)
+        list = nullptr;
+
+    current_ = 0;
+    if (blocks_.empty()) {
+        position_ = end_ = nullptr;
+    } else {
+        position_ = blocks_[0].data;
+        end_ = position_ + blocks_[0].size;
+    }
+}
+
+/**
+ * Standard allocator on top of an arena, it does not keep the arena alive
+ * so use it only for containers living inside something that does
+ * Without an arena it goes straight to operator new
+ */
+template<class T>
+class ArenaAllocator {
+  public:
+    typedef T value_type;
+
+    ArenaAllocator(): arena_(nullptr) {
+    }
+
+    explicit ArenaAllocator(Arena *arena): arena_(arena) {
+    }
+
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U> &that): arena_(that.arena()) {
+    }
+
+    T* allocate(const size_t &count) {
+        if (!arena_)
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        return static_cast<T*>(arena_->allocate(count * sizeof(T),
+                                                alignof(T)));
+    }
+
+    void deallocate(T *pointer, const size_t &count) {
+        if (!arena_)
+            return ::operator delete(pointer);
+        arena_->deallocate(pointer, count * sizeof(T));
+    }
+
+    Arena* arena() const {
+        return arena_;
+    }
+
+    template<class U>
+    bool operator==(const ArenaAllocator<U> &that) const {
+        return arena_ == that.arena();
+    }
+
+    template<class U>
+    bool operator!=(const ArenaAllocator<U> &that) const {
+        return arena_ != that.arena();
+    }
+
+  private:
+    Arena *arena_;
+};
+
+// builds an object in the arena, or on the heap if there is none
+template<class T, class... Arguments>
+T* arenaNew(Arena *arena, Arguments&&... arguments) {
+    T *memory = ArenaAllocator<T>(arena).allocate(1);
+    return new (memory) T(std::forward<Arguments>(arguments)...);
+}
+
+template<class T>
+void arenaDelete(Arena *arena, T *object) {
+    object->~T();
+    ArenaAllocator<T>(arena).deallocate(object, 1);
+}
+
+template<class T, class... Arguments>
+_Handle<T> _makeHandle(Arena *arena, Arguments&&... arguments) {
+    return _Handle<T>(arenaNew<T>(arena,
+                                  std::forward<Arguments>(arguments)...));
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_ARENA_HPP_
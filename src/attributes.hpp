@@ -0,0 +1,96 @@
+#ifndef INPUT_GENERATOR_ATTRIBUTES_HPP_
+#define INPUT_GENERATOR_ATTRIBUTES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "exception.hpp"
+#include "graph.hpp"
+#include "vectors.hpp"
+
+namespace inputGenerator {
+
+/**
+ * Node and edge attributes (weights, capacities, colors) kept next to the
+ * graph as plain arrays instead of inside it: node i is the one in position
+ * i (the one indexed graph.min() + i) and edge i is the i-th one
+ * edgeRange() gives
+ * A Graph<> and a std::vector<int> of weights take 4 bytes an edge more than
+ * the Graph<> alone, a Graph<void, int> takes a data box for every edge
+ * The positions change with Index() and with adding or erasing edges, so
+ * these are made once the graph is done (a deferred Index is fine, it only
+ * changes the labels)
+ */
+
+namespace help {
+    // randomInts for integers and randomReals for the rest
+    template<class Type>
+    typename std::enable_if<std::is_integral<Type>::value,
+                            std::vector<Type>>::type
+    randomValues(const size_t &count, const Type &from, const Type &to) {
+        return randomInts<Type>(count, from, to);
+    }
+
+    template<class Type>
+    typename std::enable_if<!std::is_integral<Type>::value,
+                            std::vector<Type>>::type
+    randomValues(const size_t &count, const Type &from, const Type &to) {
+        return randomReals<Type>(count, from, to);
+    }
+}  // namespace help
+
+// the number of edges edgeRange() goes through, in O(size + edges)
+template<class NodeData, class EdgeData>
+int64_t edgeCount(const Graph<NodeData, EdgeData> &graph) {
+    int64_t edges = 0;
+    for (auto &edge : graph.edgeRange()) {
+        static_cast<void>(edge);
+        ++edges;
+    }
+    return edges;
+}
+
+// uniform in [from, to] for integers, [from, to) for reals
+template<class Weight, class NodeData, class EdgeData>
+std::vector<Weight> nodeWeights(const Graph<NodeData, EdgeData> &graph,
+                                const Weight &from, const Weight &to) {
+    return help::randomValues<Weight>(graph.size(), from, to);
+}
+
+template<class Weight, class NodeData, class EdgeData>
+std::vector<Weight> edgeWeights(const Graph<NodeData, EdgeData> &graph,
+                                const Weight &from, const Weight &to) {
+    return help::randomValues<Weight>(edgeCount(graph), from, to);
+}
+
+// no two nodes (edges) with the same weight, in random order
+template<class Weight, class NodeData, class EdgeData>
+std::vector<Weight> distinctNodeWeights(const Graph<NodeData, EdgeData> &graph,
+                                        const Weight &from, const Weight &to) {
+    return shuffle(randomSample<Weight>(graph.size(), from, to));
+}
+
+template<class Weight, class NodeData, class EdgeData>
+std::vector<Weight> distinctEdgeWeights(const Graph<NodeData, EdgeData> &graph,
+                                        const Weight &from, const Weight &to) {
+    return shuffle(randomSample<Weight>(edgeCount(graph), from, to));
+}
+
+// the EdgeData of every edge (or anything else made from it) as an array,
+// for graphs that already have it inside
+template<class NodeData, class EdgeData, class Function>
+auto edgeAttribute(const Graph<NodeData, EdgeData> &graph, Function function)
+        -> std::vector<typename std::decay<
+               decltype(function(*graph.edgeRange().begin()))>::type> {
+    std::vector<typename std::decay<
+        decltype(function(*graph.edgeRange().begin()))>::type> result;
+    for (auto &edge : graph.edgeRange())
+        result.push_back(function(edge));
+    return result;
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_ATTRIBUTES_HPP_
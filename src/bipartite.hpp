@@ -1,17 +1,50 @@
 #ifndef INPUT_GENERATOR_BIPARTITE_HPP_
 #define INPUT_GENERATOR_BIPARTITE_HPP_
 
+#include <cstdint>
+#include <random>
 #include <utility>
 #include <algorithm>
 #include <vector>
 
 #include "exception.hpp"
+#include "flat_set.hpp"
+#include "generator.hpp"
 #include "numbers.hpp"
 #include "vectors.hpp"
 #include "graph.hpp"
+#include "sink.hpp"
 
 namespace inputGenerator {
 
+namespace help {
+    // pairs (left node, right node), each side indexed from 0
+    template<class Emit>
+    void bipartiteEdges(const int &leftSize,
+                        const int &rightSize,
+                        const int &edges,
+                        const bool &multipleEdges,
+                        Emit emit) {
+        if (multipleEdges) {
+            for (int i = 0 ; i < edges; ++i) {
+                int first = randomInt(0, leftSize - 1);
+                int second = randomInt(0, rightSize - 1);
+                emit(first, second);
+            }
+            return;
+        }
+
+        auto takenEdges = randomSample(int64_t(edges),
+                                       int64_t(0),
+                                       int64_t(leftSize) * rightSize - 1);
+        for (auto &edge : takenEdges) {
+            int first = edge / rightSize;
+            int second = edge % rightSize;
+            emit(first, second);
+        }
+    }
+}  // namespace help
+
 template<class NodeData = void, class EdgeData = void>
 std::pair<Graph<NodeData, EdgeData>, Graph<NodeData, EdgeData>> bipartite(
         const int &leftSize,
@@ -35,27 +68,41 @@ std::pair<Graph<NodeData, EdgeData>, Graph<NodeData, EdgeData>> bipartite(
     Graph<NodeData, EdgeData> leftGraph(leftSize);
     Graph<NodeData, EdgeData> rightGraph(rightSize);
 
-    if (multipleEdges) {
-        for (int i = 0 ; i < edges; ++i) {
-            int first = randomInt(0, leftSize - 1);
-            int second = randomInt(0, rightSize - 1);
-            addEdge(leftGraph[first], rightGraph[second]);
-        }
-        return std::make_pair(leftGraph, rightGraph);
-    }
-
-    auto takenEdges = randomSample(int64_t(edges),
-                                   int64_t(0),
-                                   int64_t(leftSize) * rightSize - 1);
-    for (auto &edge : takenEdges) {
-        int first = edge / rightSize;
-        int second = edge % rightSize;
+    help::bipartiteEdges(leftSize, rightSize, edges, multipleEdges,
+                         [&](const int64_t &first, const int64_t &second) {
         addEdge(leftGraph[first], rightGraph[second]);
-    }
+    });
 
     return std::make_pair(leftGraph, rightGraph);
 }
 
+// the edges go to `sink` as (left node, right node)
+template<class Sink>
+void bipartite(const int &leftSize,
+               const int &rightSize,
+               const int &edges,
+               const bool &multipleEdges,
+               Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (leftSize < 1)
+        throw Exception("`leftSize` should be strictly positive");
+    if (rightSize < 1)
+        throw Exception("`rightSize` should be strictly positive");
+
+    if (edges < 0)
+        throw Exception("`edges` (the number of edges) should be positive");
+
+    if (!multipleEdges && int64_t(leftSize) * rightSize < edges)
+        throw Exception("If multiple edges are not accepted then the number of"
+                        " edges should be strictly smaller than the product of"
+                       " the number of nodes on the left and right size");
+#endif
+    help::bipartiteEdges(leftSize, rightSize, edges, multipleEdges,
+                         [&](const int64_t &first, const int64_t &second) {
+        emitEdge(sink, first, second);
+    });
+}
+
 template<class NodeData = void, class EdgeData = void>
 std::pair<Graph<NodeData, EdgeData>, Graph<NodeData, EdgeData>> bipartite(
         const int &leftSize,
@@ -79,99 +126,393 @@ std::pair<Graph<NodeData, EdgeData>, Graph<NodeData, EdgeData>> bipartite(
     return bipartite<NodeData, EdgeData>(parts[0], parts[1], multipleEdges);
 }
 
-template<class NodeData = void, class EdgeData = void>
-std::pair<Graph<NodeData, EdgeData>, Graph<NodeData, EdgeData>>
-regularBipartite(const int &nodes, const int &degree) {
-    Graph<NodeData, EdgeData> leftGraph(nodes), rightGraph(nodes);
+// Gale and Ryser: whether some simple bipartite graph has these degrees on
+// its left and right sides, in O(left + right)
+bool isBipartiteGraphical(const std::vector<int64_t> &left,
+                          const std::vector<int64_t> &right) {
+    const int64_t leftSize = left.size(), rightSize = right.size();
+    int64_t leftSum = 0, rightSum = 0;
+    std::vector<int64_t> leftCount(rightSize + 1, 0), atLeast(leftSize + 2, 0);
+    for (auto &degree : left) {
+        if (degree < 0 || degree > rightSize)
+            return false;
+        ++leftCount[degree];
+        leftSum += degree;
+    }
+    for (auto &degree : right) {
+        if (degree < 0 || degree > leftSize)
+            return false;
+        ++atLeast[degree];
+        rightSum += degree;
+    }
+    if (leftSum != rightSum)
+        return false;
 
-    std::vector<std::vector<int>> nodesByDegree(degree + 1);
-    std::vector<std::pair<int, int>> whereMatrix(nodes);
+    // atLeast[k] is how many right nodes have a degree of at least k
+    for (int64_t k = leftSize; k >= 0; --k)
+        atLeast[k] += atLeast[k + 1];
 
-    std::vector<int> nodesArray(nodes * (degree > 1));
-    std::vector<int> whereArray(nodes);
-    for (int i = 0; i < nodes; ++i) {
-        nodesByDegree[degree].push_back(i);
-        whereMatrix[i] = {degree, i};
+    // the k biggest left degrees against the sum of min(right degree, k)
+    int64_t k = 0, biggest = 0, room = 0;
+    for (int64_t degree = rightSize; degree > 0; --degree)
+        for (int64_t i = 0; i < leftCount[degree]; ++i) {
+            ++k;
+            biggest += degree;
+            room += atLeast[k];
+            if (biggest > room)
+                return false;
+        }
+    return true;
+}
 
-        if (degree != 1)
-            nodesArray[i] = i;
-        whereArray[i] = i;
-    }
+namespace help {
+    // a bipartite graph by left node: the edges of left node a end in
+    // right[start[a]], ..., right[start[a + 1] - 1]
+    // switches keep the left ends, so only `right` ever changes
+    struct BipartiteEdges {
+        std::vector<int64_t> start;
+        std::vector<int> right;
+
+        explicit BipartiteEdges(const std::vector<int64_t> &degrees):
+                start(degrees.size() + 1, 0) {
+            for (size_t node = 0; node < degrees.size(); ++node)
+                start[node + 1] = start[node] + degrees[node];
+            right.reserve(start.back());
+        }
+
+        int64_t size() const {
+            return start.back();
+        }
 
-    auto update = [&](const int &node) -> int {
-        int row = whereMatrix[node].first;
-        int column = whereMatrix[node].second;
-        int position = whereArray[node];
+        // the left end of an edge, in O(log left)
+        int64_t left(const int64_t &edge) const {
+            return std::upper_bound(start.begin(), start.end(), edge) -
+                   start.begin() - 1;
+        }
+    };
 
-        std::swap(nodesByDegree[row][column], nodesByDegree[row].back());
-        whereMatrix[nodesByDegree[row][column]] = {row, column};
-        nodesByDegree[row].pop_back();
+    // which edges are there: a look through the left node's edges when no
+    // left node has many, a FlatSet otherwise
+    class BipartitePresence {
+      public:
+        explicit BipartitePresence(const BipartiteEdges &edges):
+                edges_(edges), hashed_(false) {
+            for (size_t node = 0; node + 1 < edges.start.size(); ++node)
+                if (edges.start[node + 1] - edges.start[node] > 1024)
+                    hashed_ = true;
+            if (!hashed_)
+                return;
+
+            present_ = FlatSet(edges.size());
+            for (size_t node = 0; node + 1 < edges.start.size(); ++node)
+                for (int64_t i = edges.start[node]; i < edges.start[node + 1];
+                     ++i)
+                    present_.insert(key(node, edges.right[i]));
+        }
 
-        if (row > 1) {
-            std::swap(nodesArray[position], nodesArray.back());
-            whereArray[nodesArray[position]] = position;
-            nodesArray.pop_back();
+        bool count(const int64_t &left, const int &right) const {
+            if (hashed_)
+                return present_.count(key(left, right));
+            for (int64_t i = edges_.start[left]; i < edges_.start[left + 1]; ++i)
+                if (edges_.right[i] == right)
+                    return true;
+            return false;
         }
 
-        return row;
+        // called after the edge changed in `edges`, `stays` if another copy
+        // of the old one is still there
+        void replace(const int64_t &left, const int &before, const int &after,
+                     const bool &stays = false) {
+            if (!hashed_)
+                return;
+            if (!stays)
+                present_.erase(key(left, before));
+            present_.insert(key(left, after));
+        }
+
+      private:
+        static uint64_t key(const int64_t &left, const int &right) {
+            return (static_cast<uint64_t>(left) << 32) |
+                   static_cast<uint32_t>(right);
+        }
+
+        const BipartiteEdges &edges_;
+        bool hashed_;
+        FlatSet present_;
     };
 
-    for (int i = 0; i < nodes; ++i) {
-        // first we have to pick all nodes of degree nodes - i
-        std::vector<std::pair<int, int>> picked;
-        picked.reserve(degree);
-
-        // the maximum amount of nodes with degree 1 we can pick is
-        // nodesArray.size() + nodesByDegre[1].size() - degree
-        int maxOnes = std::min(
-                nodesArray.size() + nodesByDegree[1].size() - degree,
-                nodesByDegree[1].size());
-
-        if (nodes - i <= degree)
-            for (auto node : std::vector<int>(nodesByDegree[nodes - i]))
-                // we need to make a copy so we don't invalidate anything
-                picked.push_back({node, update(node)});
-
-        // now we have left to pick degree  - picked.size()
-        // and we have at our disposal maxOnes nodes with degree 1
-        // and nodesArray.size() others
-        // let's try to find out first how many with degree 1 would we pick
-        int pickedOnes = 0;
-        if (degree - picked.size()) {
-            auto pickedDegree1 = randomSample<int>(degree - picked.size(),
-                                                   1,
-                                                   maxOnes + nodesArray.size());
-
-            for (auto &number : pickedDegree1)
-                if (number <= maxOnes)
-                    ++pickedOnes;
-        }
-
-        // so let's pick those with degree 1
-        for (auto &node : randomSubsequence(nodesByDegree[1], pickedOnes))
-            picked.push_back({node, update(node)});
-
-        for (auto &node : randomSubsequence(
-                    nodesArray,
-                    static_cast<int>(degree - picked.size())))
-            picked.push_back({node, update(node)});
-
-        for (auto &node : picked) {
-            addEdge(leftGraph[i], rightGraph[node.first]);
-            nodesByDegree[node.second - 1].push_back(node.first);
-            whereMatrix[node.first] = std::make_pair(
-                    node.second - 1,
-                    nodesByDegree[node.second - 1].size() - 1);
-
-            if (node.second > 2) {
-                nodesArray.push_back(node.first);
-                whereArray[node.first] = nodesArray.size() - 1;
+    // the half edges of the left nodes in order, each paired with a random
+    // half edge of the right nodes that's still free
+    inline BipartiteEdges pairBipartiteHalfEdges(
+            const std::vector<int64_t> &left,
+            const std::vector<int64_t> &right) {
+        std::vector<int> halves;
+        for (size_t node = 0; node < right.size(); ++node)
+            halves.insert(halves.end(), right[node], node);
+
+        auto &generator = Generator::getGenerator();
+        std::uniform_int_distribution<size_t> distribution;
+        typedef std::uniform_int_distribution<size_t>::param_type Range;
+
+        BipartiteEdges edges(left);
+        while (!halves.empty()) {
+            size_t other = distribution(generator,
+                                        Range(0, halves.size() - 1));
+            edges.right.push_back(halves[other]);
+            halves[other] = halves.back();
+            halves.pop_back();
+        }
+        return edges;
+    }
+
+    // (a, b) and (c, d) become (a, d) and (c, b) if neither is there yet,
+    // which keeps every degree
+    inline bool canSwitchBipartite(const BipartitePresence &present,
+                                   const int64_t &a, const int &b,
+                                   const int64_t &c, const int &d) {
+        return a != c && b != d && !present.count(a, d) &&
+               !present.count(c, b);
+    }
+
+    // repeated edges switched with random edges (two repeated ones can fix
+    // each other), false if it takes too long
+    inline bool switchBipartiteBadEdges(BipartiteEdges &edges,
+                                        const size_t &rightSize) {
+        const int64_t count = edges.size();
+        std::vector<int64_t> bad;
+        // where every bad edge is in `bad`, count for the good ones
+        std::vector<int64_t> where(count, count);
+        std::vector<int64_t> seen(rightSize, -1);
+        for (size_t node = 0; node + 1 < edges.start.size(); ++node)
+            for (int64_t i = edges.start[node]; i < edges.start[node + 1];
+                 ++i) {
+                if (seen[edges.right[i]] == static_cast<int64_t>(node)) {
+                    where[i] = bad.size();
+                    bad.push_back(i);
+                }
+                seen[edges.right[i]] = node;
+            }
+        if (bad.empty())
+            return true;
+
+        auto fixed = [&](const int64_t &edge) {
+            int64_t position = where[edge];
+            bad[position] = bad.back();
+            where[bad[position]] = position;
+            bad.pop_back();
+            where[edge] = count;
+        };
+
+        BipartitePresence present(edges);
+        auto &generator = Generator::getGenerator();
+        std::uniform_int_distribution<int64_t> distribution(0, count - 1);
+        uint64_t attempts = 20 * static_cast<uint64_t>(count) + 10000;
+        while (!bad.empty()) {
+            if (attempts-- == 0)
+                return false;
+
+            int64_t i = bad.back(), j = distribution(generator);
+            int64_t a = edges.left(i), c = edges.left(j);
+            int b = edges.right[i], d = edges.right[j];
+            if (!canSwitchBipartite(present, a, b, c, d))
+                continue;
+
+            // a bad edge leaves its twin behind
+            const bool twin = where[j] != count;
+            if (twin)
+                fixed(j);
+            fixed(i);
+            edges.right[i] = d;
+            edges.right[j] = b;
+            present.replace(a, b, d, true);
+            present.replace(c, d, b, twin);
+        }
+        return true;
+    }
+
+    // Gale and Ryser: every left node joined to the right nodes with the
+    // most left, right nodes kept in buckets by what they have left
+    inline BipartiteEdges galeRyserEdges(const std::vector<int64_t> &left,
+                                         const std::vector<int64_t> &right) {
+        int64_t top = 0;
+        for (auto &degree : right)
+            top = std::max(top, degree);
+        std::vector< std::vector<int> > bucket(top + 1);
+        for (size_t node = 0; node < right.size(); ++node)
+            if (right[node] > 0)
+                bucket[right[node]].push_back(node);
+
+        BipartiteEdges edges(left);
+        std::vector< std::pair<int, int64_t> > taken;
+        for (size_t node = 0; node < left.size(); ++node) {
+            taken.clear();
+            for (int64_t level = top; level > 0 &&
+                     static_cast<int64_t>(taken.size()) < left[node]; --level)
+                while (!bucket[level].empty() &&
+                       static_cast<int64_t>(taken.size()) < left[node]) {
+                    taken.push_back(std::make_pair(bucket[level].back(),
+                                                   level));
+                    bucket[level].pop_back();
+                }
+            if (static_cast<int64_t>(taken.size()) < left[node])
+                throw Exception("There's no bipartite graph with these "
+                                "degrees");
+
+            for (auto &other : taken) {
+                edges.right.push_back(other.first);
+                if (other.second > 1)
+                    bucket[other.second - 1].push_back(other.first);
+            }
+            while (top > 0 && bucket[top].empty())
+                --top;
+        }
+        return edges;
+    }
+
+    // random switches, enough that the graph forgets how it was built
+    inline void mixBipartiteEdges(BipartiteEdges &edges) {
+        const int64_t count = edges.size();
+        if (count < 2)
+            return;
+
+        BipartitePresence present(edges);
+        auto &generator = Generator::getGenerator();
+        std::uniform_int_distribution<int64_t> distribution(0, count - 1);
+        for (int64_t step = 0; step < 10 * count; ++step) {
+            int64_t i = distribution(generator), j = distribution(generator);
+            int64_t a = edges.left(i), c = edges.left(j);
+            int b = edges.right[i], d = edges.right[j];
+            if (!canSwitchBipartite(present, a, b, c, d))
+                continue;
+
+            edges.right[i] = d;
+            edges.right[j] = b;
+            present.replace(a, b, d);
+            present.replace(c, d, b);
+        }
+    }
+
+    // pairing and switching, Gale and Ryser and mixing when that gets stuck
+    inline BipartiteEdges simpleBipartiteEdges(
+            const std::vector<int64_t> &left,
+            const std::vector<int64_t> &right) {
+        auto edges = pairBipartiteHalfEdges(left, right);
+        if (!switchBipartiteBadEdges(edges, right.size())) {
+            edges = galeRyserEdges(left, right);
+            mixBipartiteEdges(edges);
+        }
+        return edges;
+    }
+
+    // (left node, right node) for every edge, the left nodes in order;
+    // graphs with more than half of all the pairs are made through their
+    // complement so there's little to switch
+    template<class Emit>
+    void degreeBipartiteEdges(const std::vector<int64_t> &left,
+                              const std::vector<int64_t> &right,
+                              Emit emit) {
+        const int64_t leftSize = left.size(), rightSize = right.size();
+        int64_t edges = 0;
+        for (auto &degree : left)
+            edges += degree;
+
+        if (edges > leftSize * rightSize / 2) {
+            std::vector<int64_t> leftComplement(leftSize),
+                                 rightComplement(rightSize);
+            for (int64_t i = 0; i < leftSize; ++i)
+                leftComplement[i] = rightSize - left[i];
+            for (int64_t i = 0; i < rightSize; ++i)
+                rightComplement[i] = leftSize - right[i];
+
+            auto missing = simpleBipartiteEdges(leftComplement,
+                                                rightComplement);
+            std::vector<bool> skip(rightSize, false);
+            for (int64_t node = 0; node < leftSize; ++node) {
+                const int64_t first = missing.start[node],
+                              last = missing.start[node + 1];
+                for (int64_t i = first; i < last; ++i)
+                    skip[missing.right[i]] = true;
+                for (int64_t other = 0; other < rightSize; ++other)
+                    if (!skip[other])
+                        emit(node, other);
+                for (int64_t i = first; i < last; ++i)
+                    skip[missing.right[i]] = false;
             }
+            return;
         }
+
+        auto result = simpleBipartiteEdges(left, right);
+        for (int64_t node = 0; node < leftSize; ++node)
+            for (int64_t i = result.start[node]; i < result.start[node + 1];
+                 ++i)
+                emit(node, result.right[i]);
+    }
+
+    template<class Emit>
+    void regularBipartiteEdges(const int &nodes, const int &degree, Emit emit) {
+        degreeBipartiteEdges(std::vector<int64_t>(nodes, degree),
+                             std::vector<int64_t>(nodes, degree), emit);
     }
+}  // namespace help
+
+template<class NodeData = void, class EdgeData = void>
+std::pair<Graph<NodeData, EdgeData>, Graph<NodeData, EdgeData>>
+regularBipartite(const int &nodes, const int &degree) {
+    Graph<NodeData, EdgeData> leftGraph(nodes), rightGraph(nodes);
+
+    help::regularBipartiteEdges(nodes, degree,
+                                [&](const int64_t &first, const int64_t &second) {
+        addEdge(leftGraph[first], rightGraph[second]);
+    });
+
+    return std::make_pair(leftGraph, rightGraph);
+}
+
+// the edges go to `sink` as (left node, right node)
+template<class Sink>
+void regularBipartite(const int &nodes, const int &degree, Sink sink) {
+    help::regularBipartiteEdges(nodes, degree,
+                                [&](const int64_t &first, const int64_t &second) {
+        emitEdge(sink, first, second);
+    });
+}
+
+// left node i gets left[i] neighbours and right node i gets right[i], no
+// edge twice
+template<class NodeData = void, class EdgeData = void>
+std::pair<Graph<NodeData, EdgeData>, Graph<NodeData, EdgeData>>
+degreeSequenceBipartite(const std::vector<int64_t> &left,
+                        const std::vector<int64_t> &right) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (!isBipartiteGraphical(left, right))
+        throw Exception("degreeSequenceBipartite expects degrees some simple "
+                        "bipartite graph has");
+#endif
+    Graph<NodeData, EdgeData> leftGraph(left.size()), rightGraph(right.size());
+
+    help::degreeBipartiteEdges(left, right,
+                               [&](const int64_t &first, const int64_t &second) {
+        addEdge(leftGraph[first], rightGraph[second]);
+    });
 
     return std::make_pair(leftGraph, rightGraph);
 }
 
+// the edges go to `sink` as (left node, right node)
+template<class Sink>
+void degreeSequenceBipartite(const std::vector<int64_t> &left,
+                             const std::vector<int64_t> &right,
+                             Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (!isBipartiteGraphical(left, right))
+        throw Exception("degreeSequenceBipartite expects degrees some simple "
+                        "bipartite graph has");
+#endif
+    help::degreeBipartiteEdges(left, right,
+                               [&](const int64_t &first, const int64_t &second) {
+        emitEdge(sink, first, second);
+    });
+}
+
 }  // namespace inputGenerator
 #endif  // INPUT_GENERATOR_BIPARTITE_HPP_
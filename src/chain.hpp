@@ -4,23 +4,33 @@
 #include "exception.hpp"
 #include "boolean.hpp"
 #include "graph.hpp"
+#include "sink.hpp"
 
 namespace inputGenerator {
 
+namespace help {
+    // the chain on nodes 0, 1, ..., size - 1
+    template<class Emit>
+    void chainEdges(const int64_t &size, Emit emit) {
+        for (int64_t i = 1; i < size; ++i)
+            emit(i - 1, i);
+    }
+}  // namespace help
+
 // you can generate a non-random graph if you really want
 // by making the second parameter false
 // this is undirected
 template<class NodeData = void, class EdgeData = void>
-Graph<NodeData, EdgeData> chain(const int &size = 1,
+Graph<NodeData, EdgeData> chain(const int64_t &size = 1,
                                 Boolean::Object random = Boolean::True) {
 #ifdef INPUT_GENERATOR_DEBUG
     if (size <= 0)
         throw Exception("Chains must have strictly positive sizes");
 #endif
     Graph<NodeData, EdgeData> graph(size);
-    for (int i = 1; i < size; ++i) {
-        addEdge(graph[i - 1], graph[i]);
-    }
+    help::chainEdges(size, [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
 
     if (random)
         graph.Index();
@@ -28,16 +38,30 @@ Graph<NodeData, EdgeData> chain(const int &size = 1,
     return graph;
 }
 
+// the edges go to `sink` instead, labeled the way Index() would
+template<class Sink>
+void chain(const int64_t &size, Boolean::Object random, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Chains must have strictly positive sizes");
+#endif
+    Relabeling labels(size, random);
+    help::chainEdges(size, [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
 template<class NodeData = void, class EdgeData = void>
-Graph<NodeData, EdgeData> path(const int &size = 1,
+Graph<NodeData, EdgeData> path(const int64_t &size = 1,
                                Boolean::Object random = Boolean::True) {
 #ifdef INPUT_GENERATOR_DEBUG
     if (size <= 0)
         throw Exception("Paths must have strictly positive sizes");
 #endif
     Graph<NodeData, EdgeData> graph(size);
-    for (int i = 1; i < size; ++i)
-        graph[i - 1].addEdge(graph[i]);
+    help::chainEdges(size, [&](const int64_t &from, const int64_t &to) {
+        graph[from].addEdge(graph[to]);
+    });
 
     if (random)
         graph.Index();
@@ -45,7 +69,16 @@ Graph<NodeData, EdgeData> path(const int &size = 1,
     return graph;
 }
 
+// arcs go from the first node of the path to the last
+template<class Sink>
+void path(const int64_t &size, Boolean::Object random, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Paths must have strictly positive sizes");
+#endif
+    chain(size, random, sink);
+}
+
 }  // namespace inputGenerator
 
 #endif  // INPUT_GENERATOR_CHAIN_HPP_
-
@@ -0,0 +1,389 @@
+#ifndef INPUT_GENERATOR_DEGREE_SEQUENCE_HPP_
+#define INPUT_GENERATOR_DEGREE_SEQUENCE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+#include "edge_set.hpp"
+#include "generator.hpp"
+#include "graph.hpp"
+#include "numbers.hpp"
+#include "vectors.hpp"
+#include "sink.hpp"
+
+namespace inputGenerator {
+
+/**
+ * Graphs with a given degree for every node: node i gets degrees[i] (nodes
+ * aren't relabeled, shuffle the degrees for that)
+ * Every node gets degrees[i] half edges and the half edges are paired up
+ * uniformly (the configuration model), in O(size + edges)
+ * For simple graphs the loops and repeated edges that come out are then
+ * switched away: a bad edge (a, b) and a random good one (c, d) become
+ * (a, c) and (b, d) when neither is a loop or already there, which keeps
+ * every degree; few edges are bad when the graph is sparse so this stays
+ * about linear, dense sequences are made through their complement and the
+ * rare ones where switching gets stuck are built by Havel and Hakimi and
+ * then switched at random
+ */
+
+// Erdos and Gallai, in O(size) after a counting sort
+bool isGraphical(const std::vector<int64_t> &degrees) {
+    const int64_t size = degrees.size();
+    std::vector<int64_t> count(size + 1, 0);
+    int64_t total = 0;
+    for (auto &degree : degrees) {
+        if (degree < 0 || degree >= std::max<int64_t>(size, 1))
+            return false;
+        ++count[degree];
+        total += degree;
+    }
+    if (total % 2 != 0)
+        return false;
+
+    // sorted from the biggest and their prefix sums
+    std::vector<int64_t> sorted, prefix(size + 1, 0);
+    sorted.reserve(size);
+    for (int64_t degree = size; degree >= 0; --degree)
+        sorted.insert(sorted.end(), count[degree], degree);
+    for (int64_t i = 0; i < size; ++i)
+        prefix[i + 1] = prefix[i] + sorted[i];
+
+    // the first `atLeast` have a degree of at least k
+    int64_t atLeast = size;
+    for (int64_t k = 1; k <= size; ++k) {
+        while (atLeast > 0 && sorted[atLeast - 1] < k)
+            --atLeast;
+        int64_t split = std::max(k, atLeast);
+        int64_t right = k * (k - 1) + k * (split - k) +
+                        prefix[size] - prefix[split];
+        if (prefix[k] > right)
+            return false;
+    }
+    return true;
+}
+
+namespace help {
+    // the half edges paired up uniformly: the last one left with a random
+    // one of the others, again and again
+    inline std::vector< std::pair<int64_t, int64_t> > pairHalfEdges(
+            const std::vector<int64_t> &degrees) {
+        std::vector<int64_t> halves;
+        for (size_t node = 0; node < degrees.size(); ++node)
+            halves.insert(halves.end(), degrees[node], node);
+
+        auto &generator = Generator::getGenerator();
+        std::uniform_int_distribution<size_t> distribution;
+        typedef std::uniform_int_distribution<size_t>::param_type Range;
+
+        std::vector< std::pair<int64_t, int64_t> > edges;
+        edges.reserve(halves.size() / 2);
+        while (halves.size() >= 2) {
+            int64_t last = halves.back();
+            halves.pop_back();
+            size_t other = distribution(generator,
+                                        Range(0, halves.size() - 1));
+            edges.push_back(std::make_pair(last, halves[other]));
+            halves[other] = halves.back();
+            halves.pop_back();
+        }
+        return edges;
+    }
+
+    // whether (a, b) and (c, d) can become (a, c) and (b, d): no loop and
+    // nothing that's already there
+    inline bool canSwitch(const EdgeSet &present, const int64_t &a,
+                          const int64_t &b, const int64_t &c,
+                          const int64_t &d) {
+        return a != c && b != d &&
+               EdgeSet::pack(a, c) != EdgeSet::pack(b, d) &&
+               !present.count(a, c) && !present.count(b, d);
+    }
+
+    // loops and repeated edges switched with random edges, see above; two
+    // bad edges can fix each other, false if it takes too long
+    inline bool switchBadEdges(
+            std::vector< std::pair<int64_t, int64_t> > &edges) {
+        const size_t count = edges.size();
+        EdgeSet present(count);
+        std::vector<size_t> bad;
+        // where every bad edge is in `bad`, count for the good ones
+        std::vector<size_t> where(count, count);
+        for (size_t i = 0; i < count; ++i)
+            if (edges[i].first == edges[i].second ||
+                !present.insert(edges[i].first, edges[i].second)) {
+                where[i] = bad.size();
+                bad.push_back(i);
+            }
+        if (bad.empty())
+            return true;
+
+        auto fixed = [&](const size_t &edge) {
+            size_t position = where[edge];
+            bad[position] = bad.back();
+            where[bad[position]] = position;
+            bad.pop_back();
+            where[edge] = count;
+        };
+
+        auto &generator = Generator::getGenerator();
+        std::uniform_int_distribution<size_t> distribution(0, count - 1);
+        uint64_t attempts = 20 * static_cast<uint64_t>(count) + 10000;
+        while (!bad.empty()) {
+            if (attempts-- == 0)
+                return false;
+
+            size_t i = bad.back(), j = distribution(generator);
+            if (i == j)
+                continue;
+
+            int64_t a = edges[i].first, b = edges[i].second;
+            int64_t c = edges[j].first, d = edges[j].second;
+            if (generator() & 1)
+                std::swap(c, d);
+            if (!canSwitch(present, a, b, c, d))
+                continue;
+
+            // a bad edge is not in `present`, or it's there for its twin
+            if (where[j] == count)
+                present.erase(c, d);
+            else
+                fixed(j);
+            fixed(i);
+            present.insert(a, c);
+            present.insert(b, d);
+            edges[i] = std::make_pair(a, c);
+            edges[j] = std::make_pair(b, d);
+        }
+        return true;
+    }
+
+    // Havel and Hakimi: the node with the most left joined to the ones with
+    // the most left after it, nodes kept in buckets by what they have left
+    inline std::vector< std::pair<int64_t, int64_t> > havelHakimiEdges(
+            const std::vector<int64_t> &degrees) {
+        int64_t top = 0;
+        for (auto &degree : degrees)
+            top = std::max(top, degree);
+        std::vector< std::vector<int64_t> > bucket(top + 1);
+        for (size_t node = 0; node < degrees.size(); ++node)
+            if (degrees[node] > 0)
+                bucket[degrees[node]].push_back(node);
+
+        std::vector< std::pair<int64_t, int64_t> > edges, taken;
+        while (top > 0) {
+            int64_t node = bucket[top].back();
+            bucket[top].pop_back();
+
+            taken.clear();
+            for (int64_t level = top; level > 0 &&
+                     static_cast<int64_t>(taken.size()) < top; --level)
+                while (!bucket[level].empty() &&
+                       static_cast<int64_t>(taken.size()) < top) {
+                    taken.push_back(std::make_pair(bucket[level].back(),
+                                                   level));
+                    bucket[level].pop_back();
+                }
+            if (static_cast<int64_t>(taken.size()) < top)
+                throw Exception("There's no simple graph with these degrees");
+
+            for (auto &other : taken) {
+                edges.push_back(std::make_pair(node, other.first));
+                if (other.second > 1)
+                    bucket[other.second - 1].push_back(other.first);
+            }
+            while (top > 0 && bucket[top].empty())
+                --top;
+        }
+        return edges;
+    }
+
+    // random switches between any two edges, enough of them that the graph
+    // forgets how it was built
+    inline void mixEdges(std::vector< std::pair<int64_t, int64_t> > &edges) {
+        const size_t count = edges.size();
+        if (count < 2)
+            return;
+
+        EdgeSet present(count);
+        for (auto &edge : edges)
+            present.insert(edge.first, edge.second);
+
+        auto &generator = Generator::getGenerator();
+        std::uniform_int_distribution<size_t> distribution(0, count - 1);
+        for (size_t step = 0; step < 10 * count; ++step) {
+            size_t i = distribution(generator), j = distribution(generator);
+            int64_t a = edges[i].first, b = edges[i].second;
+            int64_t c = edges[j].first, d = edges[j].second;
+            if (generator() & 1)
+                std::swap(c, d);
+            if (i == j || !canSwitch(present, a, b, c, d))
+                continue;
+
+            present.erase(a, b);
+            present.erase(c, d);
+            present.insert(a, c);
+            present.insert(b, d);
+            edges[i] = std::make_pair(a, c);
+            edges[j] = std::make_pair(b, d);
+        }
+    }
+
+    // pairing and switching, or for the few sequences where that gets stuck
+    // (a node joined to almost everything) Havel and Hakimi and then mixing
+    inline std::vector< std::pair<int64_t, int64_t> > simpleEdges(
+            const std::vector<int64_t> &degrees) {
+        auto edges = pairHalfEdges(degrees);
+        if (!switchBadEdges(edges)) {
+            edges = havelHakimiEdges(degrees);
+            mixEdges(edges);
+            randomShuffle(edges.begin(), edges.end());
+        }
+        return edges;
+    }
+
+    // a simple graph with these degrees, the edges in random order
+    template<class Emit>
+    void degreeSequenceEdges(const std::vector<int64_t> &degrees, Emit emit) {
+        const int64_t size = degrees.size();
+        int64_t total = 0;
+        for (auto &degree : degrees)
+            total += degree;
+
+        // more than half of all the pairs: the complement has fewer edges
+        if (total / 2 > size * (size - 1) / 4) {
+            std::vector<int64_t> complement(size);
+            for (int64_t i = 0; i < size; ++i)
+                complement[i] = size - 1 - degrees[i];
+            auto edges = simpleEdges(complement);
+
+            EdgeSet missing(edges.size());
+            for (auto &edge : edges)
+                missing.insert(edge.first, edge.second);
+            for (int64_t from = 0; from < size; ++from)
+                for (int64_t to = from + 1; to < size; ++to)
+                    if (!missing.count(from, to))
+                        emit(from, to);
+            return;
+        }
+
+        for (auto &edge : simpleEdges(degrees))
+            emit(edge.first, edge.second);
+    }
+
+    inline int64_t degreeSum(const std::vector<int64_t> &degrees) {
+        int64_t total = 0;
+        for (auto &degree : degrees)
+            total += degree;
+        return total;
+    }
+}  // namespace help
+
+// `size` degrees from [minimum, maximum] with P(k) proportional to
+// k^-exponent and an even sum (one of them moves by one if it's odd)
+std::vector<int64_t> powerLawDegrees(const size_t &size,
+                                     const double &exponent,
+                                     const int64_t &minimum,
+                                     const int64_t &maximum) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0 || minimum > maximum || minimum <= 0)
+        throw Exception("powerLawDegrees expects some nodes and 0 < "
+                        "`minimum` <= `maximum`");
+#endif
+    auto degrees = randomPowerLaw<int64_t>(size, exponent, minimum, maximum);
+    if (help::degreeSum(degrees) % 2 != 0) {
+        int64_t &degree = degrees[randomInt<size_t>(0, size - 1)];
+        degree += degree < maximum ? 1 : -1;
+    }
+    return degrees;
+}
+
+// the configuration model itself: loops and repeated edges stay
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> configurationModel(
+        const std::vector<int64_t> &degrees) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (help::degreeSum(degrees) % 2 != 0)
+        throw Exception("configurationModel expects the degrees to add up to "
+                        "an even number");
+#endif
+    Graph<NodeData, EdgeData> graph(degrees.size());
+    for (auto &edge : help::pairHalfEdges(degrees))
+        addEdge(graph[edge.first], graph[edge.second]);
+
+    return graph;
+}
+
+template<class Sink>
+void configurationModel(const std::vector<int64_t> &degrees, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (help::degreeSum(degrees) % 2 != 0)
+        throw Exception("configurationModel expects the degrees to add up to "
+                        "an even number");
+#endif
+    for (auto &edge : help::pairHalfEdges(degrees))
+        emitEdge(sink, edge.first, edge.second);
+}
+
+// a simple graph where node i has degree degrees[i]
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> degreeSequenceGraph(
+        const std::vector<int64_t> &degrees) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (!isGraphical(degrees))
+        throw Exception("degreeSequenceGraph expects degrees some simple "
+                        "graph has");
+#endif
+    Graph<NodeData, EdgeData> graph(degrees.size());
+    help::degreeSequenceEdges(degrees,
+                              [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+
+    return graph;
+}
+
+template<class Sink>
+void degreeSequenceGraph(const std::vector<int64_t> &degrees, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (!isGraphical(degrees))
+        throw Exception("degreeSequenceGraph expects degrees some simple "
+                        "graph has");
+#endif
+    help::degreeSequenceEdges(degrees,
+                              [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
+
+// every node with exactly `degree` neighbours
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> regularGraph(const size_t &size,
+                                       const size_t &degree) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (degree >= std::max<size_t>(size, 1) || size * degree % 2 != 0)
+        throw Exception("Regular graphs need `degree` < `size` and an even "
+                        "`size` * `degree`");
+#endif
+    return degreeSequenceGraph<NodeData, EdgeData>(
+        std::vector<int64_t>(size, degree));
+}
+
+template<class Sink>
+void regularGraph(const size_t &size, const size_t &degree, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (degree >= std::max<size_t>(size, 1) || size * degree % 2 != 0)
+        throw Exception("Regular graphs need `degree` < `size` and an even "
+                        "`size` * `degree`");
+#endif
+    degreeSequenceGraph(std::vector<int64_t>(size, degree), sink);
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_DEGREE_SEQUENCE_HPP_
@@ -0,0 +1,556 @@
+#ifndef INPUT_GENERATOR_DIRECTED_GRAPH_HPP_
+#define INPUT_GENERATOR_DIRECTED_GRAPH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+#include "graph.hpp"
+#include "numbers.hpp"
+#include "vectors.hpp"
+#include "sink.hpp"
+#include "undirected_graph.hpp"
+
+namespace inputGenerator {
+
+/**
+ * Directed graphs in O(size + arcs): DAGs and graphs with known strongly
+ * connected components
+ * The arcs that may appear are numbered block by block, the ones that must
+ * appear (a path, a cycle) are taken and the rest is a uniform sample of the
+ * other numbers, so nothing is drawn twice and nothing is thrown away
+ * The nodes are labeled at random the way Graph::Index does it, so the
+ * topological order and the components stay hidden; sinks get the arcs as
+ * (from, to)
+ */
+
+namespace help {
+    // the numbering of the arcs, made of blocks of consecutive numbers
+    class ArcSpace {
+      public:
+        ArcSpace(): total_(0) {
+        }
+
+        // from every node of [from, from + rows) to every node of
+        // [to, to + columns)
+        size_t addRectangle(const int64_t &from, const int64_t &rows,
+                            const int64_t &to, const int64_t &columns);
+
+        // between any two different nodes of [first, first + size)
+        size_t addAllPairs(const int64_t &first, const int64_t &size);
+
+        // from smaller to bigger nodes of [first, first + size)
+        size_t addUpPairs(const int64_t &first, const int64_t &size);
+
+        int64_t size() const {
+            return total_;
+        }
+
+        // the number of the arc from -> to of block `block`
+        int64_t id(const size_t &block, const int64_t &from,
+                   const int64_t &to) const;
+
+        // the arcs of numbers given in increasing order
+        template<class Emit>
+        void arcs(const std::vector<int64_t> &ids, Emit emit) const;
+
+      private:
+        enum Kind { kRectangle, kAllPairs, kUpPairs };
+
+        struct Block {
+            Kind kind;
+            int64_t from, rows, to, columns;
+            int64_t first, last;
+        };
+
+        size_t add(const Kind &kind, const int64_t &from, const int64_t &rows,
+                   const int64_t &to, const int64_t &columns,
+                   const int64_t &size);
+
+        std::vector<Block> blocks_;
+        int64_t total_;
+    };
+
+    size_t ArcSpace::add(const Kind &kind, const int64_t &from,
+                         const int64_t &rows, const int64_t &to,
+                         const int64_t &columns, const int64_t &size) {
+        Block block = {kind, from, rows, to, columns, total_, total_ + size};
+        blocks_.push_back(block);
+        total_ += size;
+        return blocks_.size() - 1;
+    }
+
+    size_t ArcSpace::addRectangle(const int64_t &from, const int64_t &rows,
+                                  const int64_t &to, const int64_t &columns) {
+        return add(kRectangle, from, rows, to, columns, rows * columns);
+    }
+
+    size_t ArcSpace::addAllPairs(const int64_t &first, const int64_t &size) {
+        return add(kAllPairs, first, size, first, size, size * (size - 1));
+    }
+
+    size_t ArcSpace::addUpPairs(const int64_t &first, const int64_t &size) {
+        return add(kUpPairs, first, size, first, size, size * (size - 1) / 2);
+    }
+
+    int64_t ArcSpace::id(const size_t &block, const int64_t &from,
+                         const int64_t &to) const {
+        const Block &where = blocks_[block];
+        int64_t row = from - where.from, column = to - where.to;
+        switch (where.kind) {
+            case kRectangle:
+                return where.first + row * where.columns + column;
+            case kAllPairs:
+                return where.first + row * (where.rows - 1) +
+                       (column < row ? column : column - 1);
+            default:
+                return where.first + row * (2 * where.rows - row - 1) / 2 +
+                       column - row - 1;
+        }
+    }
+
+    template<class Emit>
+    void ArcSpace::arcs(const std::vector<int64_t> &ids, Emit emit) const {
+        size_t block = 0;
+        // where the current row starts, for the blocks of pairs going up
+        int64_t row = 0, rowStart = 0;
+        for (auto &id : ids) {
+            while (id >= blocks_[block].last) {
+                ++block;
+                row = rowStart = 0;
+            }
+
+            const Block &where = blocks_[block];
+            int64_t local = id - where.first;
+            if (where.kind == kRectangle) {
+                emit(where.from + local / where.columns,
+                     where.to + local % where.columns);
+            } else if (where.kind == kAllPairs) {
+                int64_t from = local / (where.rows - 1);
+                int64_t to = local % (where.rows - 1);
+                emit(where.from + from, where.from + to + (to >= from));
+            } else {
+                while (local >= rowStart + where.rows - row - 1) {
+                    rowStart += where.rows - row - 1;
+                    ++row;
+                }
+                emit(where.from + row, where.from + local - rowStart + row + 1);
+            }
+        }
+    }
+
+    // `parts` sizes that differ by at most one and add up to `size`
+    inline std::vector<int64_t> evenParts(const int64_t &size,
+                                          const int64_t &parts) {
+        std::vector<int64_t> result(parts, size / parts);
+        for (int64_t i = 0; i < size % parts; ++i)
+            ++result[i];
+        return result;
+    }
+
+    // arcs only go from smaller to bigger nodes, a path through `pathNodes`
+    // random nodes is always there (no path for less than two)
+    template<class Emit>
+    void dagArcs(const size_t &size, const size_t &arcs,
+                 const size_t &pathNodes, Emit emit) {
+        if (size < 2)
+            return;
+
+        ArcSpace space;
+        space.addUpPairs(0, size);
+
+        std::vector<int64_t> path, taken;
+        if (pathNodes >= 2)
+            path = randomSample<int64_t>(pathNodes, 0, size - 1);
+        for (size_t i = 1; i < path.size(); ++i)
+            taken.push_back(space.id(0, path[i - 1], path[i]));
+
+        const int64_t others = arcs - taken.size();
+        space.arcs(sampleAround(others, space.size(), std::move(taken)), emit);
+    }
+
+    // arcs only go from a layer to the next one, a path through a random
+    // node of every layer is always there
+    template<class Emit>
+    void layeredDagArcs(const std::vector<int64_t> &layers,
+                        const size_t &arcs, Emit emit) {
+        ArcSpace space;
+        std::vector<int64_t> taken;
+        int64_t first = 0;
+        int64_t pathNode =
+            layers.empty() ? 0 : randomInt<int64_t>(0, layers[0] - 1);
+        for (size_t i = 1; i < layers.size(); ++i) {
+            int64_t next = first + layers[i - 1];
+            size_t block = space.addRectangle(first, layers[i - 1],
+                                              next, layers[i]);
+            int64_t nextPathNode = next + randomInt<int64_t>(0, layers[i] - 1);
+            taken.push_back(space.id(block, pathNode, nextPathNode));
+
+            first = next;
+            pathNode = nextPathNode;
+        }
+
+        const int64_t others = arcs - taken.size();
+        space.arcs(sampleAround(others, space.size(), std::move(taken)), emit);
+    }
+
+    // every component is a block of consecutive nodes with a cycle through
+    // all of them, every arc (c, d) of `condensation` is a block of arcs
+    // from component c to component d with at least one arc in it
+    template<class Emit>
+    void componentGraphArcs(
+            const std::vector<int64_t> &components,
+            const size_t &arcs,
+            const std::vector< std::pair<int64_t, int64_t> > &condensation,
+            Emit emit) {
+        ArcSpace space;
+        std::vector<int64_t> first(components.size() + 1, 0), taken;
+        for (size_t i = 0; i < components.size(); ++i) {
+            first[i + 1] = first[i] + components[i];
+            if (components[i] < 2)
+                continue;
+
+            // i -> i + 1 comes before i + 1 -> i + 2 and the arc back to the
+            // first node is the last one of the block
+            size_t block = space.addAllPairs(first[i], components[i]);
+            for (int64_t node = first[i]; node + 1 < first[i + 1]; ++node)
+                taken.push_back(space.id(block, node, node + 1));
+            taken.push_back(space.id(block, first[i + 1] - 1, first[i]));
+        }
+
+        for (auto &arc : condensation) {
+            int64_t from = arc.first, to = arc.second;
+            size_t block = space.addRectangle(first[from], components[from],
+                                              first[to], components[to]);
+            taken.push_back(space.id(
+                block,
+                first[from] + randomInt<int64_t>(0, components[from] - 1),
+                first[to] + randomInt<int64_t>(0, components[to] - 1)));
+        }
+
+        const int64_t others = arcs - taken.size();
+        space.arcs(sampleAround(others, space.size(), std::move(taken)), emit);
+    }
+
+    inline int64_t componentArcs(const std::vector<int64_t> &components) {
+        int64_t arcs = 0;
+        for (auto &size : components)
+            if (size > 1)
+                arcs += size;
+        return arcs;
+    }
+
+    // the checks of componentGraph, the condensation must be a DAG
+    inline void checkComponentGraph(
+            const std::vector<int64_t> &components,
+            const size_t &arcs,
+            const std::vector< std::pair<int64_t, int64_t> > &condensation) {
+        const int64_t count = components.size();
+        if (count == 0)
+            throw Exception("componentGraph expects at least one component");
+
+        int64_t most = 0;
+        for (auto &size : components) {
+            if (size <= 0)
+                throw Exception("componentGraph expects strictly positive "
+                                "component sizes");
+            most += size * (size - 1);
+        }
+
+        std::vector<int64_t> inDegree(count, 0), offsets(count + 1, 0);
+        for (auto &arc : condensation) {
+            if (arc.first < 0 || arc.first >= count ||
+                arc.second < 0 || arc.second >= count)
+                throw Exception("componentGraph expects the condensation to "
+                                "be on components 0 to `components` - 1");
+            ++inDegree[arc.second];
+            ++offsets[arc.first + 1];
+            most += components[arc.first] * components[arc.second];
+        }
+
+        auto sorted = condensation;
+        std::sort(sorted.begin(), sorted.end());
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+            throw Exception("componentGraph expects distinct condensation "
+                            "arcs");
+
+        // Kahn's algorithm on the condensation
+        for (int64_t i = 0; i < count; ++i)
+            offsets[i + 1] += offsets[i];
+        std::vector<int64_t> ready;
+        for (int64_t i = 0; i < count; ++i)
+            if (inDegree[i] == 0)
+                ready.push_back(i);
+        int64_t removed = 0;
+        while (!ready.empty()) {
+            int64_t component = ready.back();
+            ready.pop_back();
+            ++removed;
+            for (int64_t i = offsets[component];
+                 i < offsets[component + 1]; ++i)
+                if (--inDegree[sorted[i].second] == 0)
+                    ready.push_back(sorted[i].second);
+        }
+        if (removed != count)
+            throw Exception("componentGraph expects the condensation to have "
+                            "no cycles");
+
+        int64_t least = componentArcs(components) + condensation.size();
+        if (static_cast<int64_t>(arcs) < least ||
+            static_cast<int64_t>(arcs) > most)
+            throw Exception("componentGraph expects at least one cycle a "
+                            "component and one arc a condensation arc, and "
+                            "no more arcs than there is room for");
+    }
+
+    // the components in a row, every one with an arc to the next
+    inline std::vector< std::pair<int64_t, int64_t> > chainCondensation(
+            const size_t &components) {
+        std::vector< std::pair<int64_t, int64_t> > condensation;
+        for (size_t i = 1; i < components; ++i)
+            condensation.push_back(std::make_pair(i - 1, i));
+        return condensation;
+    }
+}  // namespace help
+
+// a uniform DAG with `arcs` arcs among the ones that go up a random order
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> dag(const size_t &size, const size_t &arcs) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0 || arcs > static_cast<uint64_t>(size) * (size - 1) / 2)
+        throw Exception("DAGs must have strictly positive sizes and at most "
+                        "`size` * (`size` - 1) / 2 arcs");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::dagArcs(size, arcs, 0, [&](const int64_t &from, const int64_t &to) {
+        graph[from].addEdge(graph[to]);
+    });
+
+    graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void dag(const size_t &size, const size_t &arcs, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0 || arcs > static_cast<uint64_t>(size) * (size - 1) / 2)
+        throw Exception("DAGs must have strictly positive sizes and at most "
+                        "`size` * (`size` - 1) / 2 arcs");
+#endif
+    Relabeling labels(size);
+    help::dagArcs(size, arcs, 0, [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+// a DAG with a path through at least `pathNodes` nodes, `size` of them
+// leaves exactly one topological order
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> longPathDag(const size_t &size, const size_t &arcs,
+                                      const size_t &pathNodes) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (pathNodes <= 0 || pathNodes > size || arcs + 1 < pathNodes ||
+        arcs > static_cast<uint64_t>(size) * (size - 1) / 2)
+        throw Exception("longPathDag expects a path of 1 to `size` nodes, at "
+                        "least as many arcs as the path and at most `size` * "
+                        "(`size` - 1) / 2");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::dagArcs(size, arcs, pathNodes,
+                  [&](const int64_t &from, const int64_t &to) {
+        graph[from].addEdge(graph[to]);
+    });
+
+    graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void longPathDag(const size_t &size, const size_t &arcs,
+                 const size_t &pathNodes, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (pathNodes <= 0 || pathNodes > size || arcs + 1 < pathNodes ||
+        arcs > static_cast<uint64_t>(size) * (size - 1) / 2)
+        throw Exception("longPathDag expects a path of 1 to `size` nodes, at "
+                        "least as many arcs as the path and at most `size` * "
+                        "(`size` - 1) / 2");
+#endif
+    Relabeling labels(size);
+    help::dagArcs(size, arcs, pathNodes,
+                  [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+// the nodes split in layers of the given sizes, arcs go from a layer to the
+// next and the longest path goes through all of them
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> layeredDag(const std::vector<int64_t> &layers,
+                                     const size_t &arcs) {
+    int64_t size = 0, most = 0;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        size += layers[i];
+        if (i > 0)
+            most += layers[i - 1] * layers[i];
+    }
+#ifdef INPUT_GENERATOR_DEBUG
+    if (layers.empty() || *std::min_element(layers.begin(), layers.end()) <= 0)
+        throw Exception("layeredDag expects at least one layer and strictly "
+                        "positive layer sizes");
+
+    if (arcs + 1 < layers.size() || static_cast<int64_t>(arcs) > most)
+        throw Exception("layeredDag expects an arc between every two layers "
+                        "and at most as many arcs as there is room for");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::layeredDagArcs(layers, arcs,
+                         [&](const int64_t &from, const int64_t &to) {
+        graph[from].addEdge(graph[to]);
+    });
+
+    graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void layeredDag(const std::vector<int64_t> &layers, const size_t &arcs,
+                Sink sink) {
+    int64_t size = 0, most = 0;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        size += layers[i];
+        if (i > 0)
+            most += layers[i - 1] * layers[i];
+    }
+#ifdef INPUT_GENERATOR_DEBUG
+    if (layers.empty() || *std::min_element(layers.begin(), layers.end()) <= 0)
+        throw Exception("layeredDag expects at least one layer and strictly "
+                        "positive layer sizes");
+
+    if (arcs + 1 < layers.size() || static_cast<int64_t>(arcs) > most)
+        throw Exception("layeredDag expects an arc between every two layers "
+                        "and at most as many arcs as there is room for");
+#endif
+    Relabeling labels(size);
+    help::layeredDagArcs(layers, arcs,
+                         [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+// `layers` layers as even as they can be, for uneven ones give the sizes
+// (randomPartition makes random ones)
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> layeredDag(const size_t &size, const size_t &layers,
+                                     const size_t &arcs) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (layers <= 0 || layers > size)
+        throw Exception("layeredDag expects 1 to `size` layers");
+#endif
+    return layeredDag<NodeData, EdgeData>(help::evenParts(size, layers), arcs);
+}
+
+template<class Sink>
+void layeredDag(const size_t &size, const size_t &layers, const size_t &arcs,
+                Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (layers <= 0 || layers > size)
+        throw Exception("layeredDag expects 1 to `size` layers");
+#endif
+    layeredDag(help::evenParts(size, layers), arcs, sink);
+}
+
+// components of the given sizes, every one strongly connected (through a
+// cycle over all its nodes) and arcs between them only along the arcs of
+// `condensation`, which must be a DAG on 0 to components.size() - 1 and
+// comes out as the condensation of the graph, every one of its arcs at
+// least once
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> componentGraph(
+        const std::vector<int64_t> &components,
+        const size_t &arcs,
+        const std::vector< std::pair<int64_t, int64_t> > &condensation) {
+#ifdef INPUT_GENERATOR_DEBUG
+    help::checkComponentGraph(components, arcs, condensation);
+#endif
+    int64_t size = 0;
+    for (auto &component : components)
+        size += component;
+
+    Graph<NodeData, EdgeData> graph(size);
+    help::componentGraphArcs(components, arcs, condensation,
+                             [&](const int64_t &from, const int64_t &to) {
+        graph[from].addEdge(graph[to]);
+    });
+
+    graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void componentGraph(
+        const std::vector<int64_t> &components,
+        const size_t &arcs,
+        const std::vector< std::pair<int64_t, int64_t> > &condensation,
+        Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    help::checkComponentGraph(components, arcs, condensation);
+#endif
+    int64_t size = 0;
+    for (auto &component : components)
+        size += component;
+
+    Relabeling labels(size);
+    help::componentGraphArcs(components, arcs, condensation,
+                             [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+// `components` components as even as they can be, in a row
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> componentGraph(const size_t &size,
+                                         const size_t &components,
+                                         const size_t &arcs) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (components <= 0 || components > size)
+        throw Exception("componentGraph expects 1 to `size` components");
+#endif
+    return componentGraph<NodeData, EdgeData>(
+        help::evenParts(size, components), arcs,
+        help::chainCondensation(components));
+}
+
+template<class Sink>
+void componentGraph(const size_t &size, const size_t &components,
+                    const size_t &arcs, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (components <= 0 || components > size)
+        throw Exception("componentGraph expects 1 to `size` components");
+#endif
+    componentGraph(help::evenParts(size, components), arcs,
+                   help::chainCondensation(components), sink);
+}
+
+// one component: strongly connected, with at least `size` arcs (a single
+// node has none)
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> stronglyConnectedGraph(const size_t &size,
+                                                 const size_t &arcs) {
+    return componentGraph<NodeData, EdgeData>(
+        std::vector<int64_t>(1, size), arcs,
+        std::vector< std::pair<int64_t, int64_t> >());
+}
+
+template<class Sink>
+void stronglyConnectedGraph(const size_t &size, const size_t &arcs,
+                            Sink sink) {
+    componentGraph(std::vector<int64_t>(1, size), arcs,
+                   std::vector< std::pair<int64_t, int64_t> >(), sink);
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_DIRECTED_GRAPH_HPP_
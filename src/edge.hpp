@@ -1,7 +1,11 @@
 #if !defined(INPUT_GENERATOR_EDGE_HPP_)
 #define INPUT_GENERATOR_EDGE_HPP_
 
-#include <memory>
+#include <atomic>
+#include <cstdint>
+
+#include "arena.hpp"
+#include "handle.hpp"
 
 namespace inputGenerator {
 
@@ -12,77 +16,120 @@ class _NodeBase;
 template<class NodeData, class EdgeData>
 class NodeWrapper;
 
+template<class NodeData, class EdgeData>
+class NodeWrapperBase;
+
 template<class NodeData, class EdgeData>
 class _Node;
 #endif
 
+template<class NodeData, class EdgeData>
+class Graph;
+
+/**
+ * Edge keys, unique across every graph and thread
+ * Each thread takes a block of keys at a time so we rarely touch the atomic
+ */
+class _EdgeKeys {
+  public:
+    static uint64_t next();
+
+  private:
+    static const uint64_t kBlock = 1 << 16;
+
+    static std::atomic<uint64_t> taken;
+};
+
+const uint64_t _EdgeKeys::kBlock;
+
+std::atomic<uint64_t> _EdgeKeys::taken(0);
+
+uint64_t _EdgeKeys::next() {
+    static thread_local uint64_t current = 0, end = 0;
+    if (current == end) {
+        current = taken.fetch_add(kBlock);
+        end = current + kBlock;
+    }
+    return current++;
+}
+
 template<class NodeData, class EdgeData>
 class _EdgeBase {
   public:
     typedef _Node<NodeData, EdgeData> NodeType;
     typedef _EdgeBase<NodeData, EdgeData> EdgeType;
 
-    _EdgeBase(const _EdgeBase&);
-
-    _EdgeBase(const std::shared_ptr<NodeType>&,
-              const std::shared_ptr<NodeType>&);
+    _EdgeBase(const _Handle<NodeType>&,
+              const _Handle<NodeType>&);
 
-    _EdgeBase(const std::shared_ptr<NodeType>&,
-              const std::shared_ptr<NodeType>&,
-              const int&);
+    _EdgeBase(const _Handle<NodeType>&,
+              const _Handle<NodeType>&,
+              const uint64_t&);
 
-    const unsigned& getKey() const;
+    uint64_t getKey() const;
 
     NodeWrapper<NodeData, EdgeData> from() const;
 
     NodeWrapper<NodeData, EdgeData> to() const;
 
+    // same as from().index() and to().index() without making a handle
+    const int64_t& fromIndex() const;
+
+    const int64_t& toIndex() const;
+
+    // whether this is an edge (it also lives in `to`) and not just an arc
+    // only edges read from a node are up to date
+    bool isEdge() const {
+        return (key & kEdgeBit) != 0;
+    }
+
     bool operator==(const EdgeType&) const;
 
   protected:
-    std::weak_ptr<NodeType> _from, _to;
+    void setEdge(const bool &isEdge) {
+        if (isEdge)
+            key |= kEdgeBit;
+        else
+            key &= ~kEdgeBit;
+    }
+
+    _WeakHandle<NodeType> _from, _to;
 
     friend class _NodeBase<NodeData, EdgeData>;
+    friend class NodeWrapperBase<NodeData, EdgeData>;
+    friend class Graph<NodeData, EdgeData>;
 
-    // auto-increment value to assign each each a key
-    // so edge from x to y should match edge to y to x
-    static unsigned keyCount;
+    // the top bit of the key is isEdge()
+    static const uint64_t kEdgeBit = uint64_t(1) << 63;
 
-    // the key itself
-    unsigned key;
+    // the key itself, from _EdgeKeys
+    // so edge from x to y should match edge to y to x
+    uint64_t key;
 };
 
 template<class NodeData, class EdgeData>
-unsigned _EdgeBase<NodeData, EdgeData>::keyCount = 0;
+const uint64_t _EdgeBase<NodeData, EdgeData>::kEdgeBit;
 
 template<class NodeData, class EdgeData>
-_EdgeBase<NodeData, EdgeData>::_EdgeBase(
-        const _EdgeBase<NodeData, EdgeData>& that) {
-    _from = that._from;
-    _to = that._to;
-    key = that.key;
+_EdgeBase<NodeData, EdgeData>::_EdgeBase(const _Handle<NodeType>& from,
+                                         const _Handle<NodeType>& to):
+        _from(from),
+        _to(to) {
+    key = _EdgeKeys::next();
 }
 
 template<class NodeData, class EdgeData>
-_EdgeBase<NodeData, EdgeData>::_EdgeBase(const std::shared_ptr<NodeType>& from,
-                                 const std::shared_ptr<NodeType>& to) {
-    _from = from;
-    _to = to;
-    key = keyCount++;
-}
-
-template<class NodeData, class EdgeData>
-_EdgeBase<NodeData, EdgeData>::_EdgeBase(const std::shared_ptr<NodeType>& from,
-                                 const std::shared_ptr<NodeType>& to,
-                                 const int &_key) {
-    _from = from;
-    _to = to;
+_EdgeBase<NodeData, EdgeData>::_EdgeBase(const _Handle<NodeType>& from,
+                                         const _Handle<NodeType>& to,
+                                         const uint64_t &_key):
+        _from(from),
+        _to(to) {
     key = _key;
 }
 
 template<class NodeData, class EdgeData>
-const unsigned& _EdgeBase<NodeData, EdgeData>::getKey() const {
-    return key;
+uint64_t _EdgeBase<NodeData, EdgeData>::getKey() const {
+    return key & ~kEdgeBit;
 }
 
 template<class NodeData, class EdgeData>
@@ -95,47 +142,81 @@ NodeWrapper<NodeData, EdgeData> _EdgeBase<NodeData, EdgeData>::to() const {
     return NodeWrapper<NodeData, EdgeData>(_to.lock());
 }
 
+template<class NodeData, class EdgeData>
+const int64_t& _EdgeBase<NodeData, EdgeData>::fromIndex() const {
+    return _from.get()->index;
+}
+
+template<class NodeData, class EdgeData>
+const int64_t& _EdgeBase<NodeData, EdgeData>::toIndex() const {
+    return _to.get()->index;
+}
+
 template<class NodeData, class EdgeData>
 bool _EdgeBase<NodeData, EdgeData>::operator==(
         const _EdgeBase<NodeData, EdgeData> &edge) const {
     return getKey() == edge.getKey();
 }
 
+// the data of an edge, shared by both of its ends
+template<class EdgeData>
+class _EdgeDataBox : public _Counted {
+  public:
+    explicit _EdgeDataBox(Arena *arena): data(), arena_(arena) {
+    }
+
+    static void _destroy(_EdgeDataBox *box) {
+        _Handle<Arena> arena(box->arena_);
+        arenaDelete(arena.get(), box);
+    }
+
+    EdgeData data;
+
+  private:
+    _Handle<Arena> arena_;
+};
+
 /**
- * Memory used is 20 bytes + (the data which by default is 0, hopefully)
+ * Memory used is 32 bytes + (the data which by default is 0, hopefully)
  */
 template<class NodeData, class EdgeData>
 class _Edge : public _EdgeBase<NodeData, EdgeData> {
   public:
     typedef _Node<NodeData, EdgeData> NodeType;
     typedef _Edge<NodeData, EdgeData> EdgeType;
+    typedef _Handle<_EdgeDataBox<EdgeData>> DataPointer;
 
-    _Edge(const _Edge& that):
-            _EdgeBase<NodeData, EdgeData>(that) {
-        _data = that._data;
+    _Edge(const _Handle<NodeType>& from,
+          const _Handle<NodeType>& to):
+            _EdgeBase<NodeData, EdgeData>(from, to) {
+        // the data lives next to the nodes that own the edge
+        _data = _makeHandle<_EdgeDataBox<EdgeData>>(from->arena(),
+                                                    from->arena());
     }
 
-    _Edge(const std::shared_ptr<NodeType>& from,
-          const std::shared_ptr<NodeType>& to):
-            _EdgeBase<NodeData, EdgeData>(from, to) {
-        _data.reset(new EdgeData());
+    _Edge(const _Handle<NodeType>& from,
+          const _Handle<NodeType>& to,
+          const uint64_t& key):
+            _EdgeBase<NodeData, EdgeData>(from, to, key) {
+        _data = _makeHandle<_EdgeDataBox<EdgeData>>(from->arena(),
+                                                    from->arena());
     }
 
-    _Edge(const std::shared_ptr<NodeType>& from,
-          const std::shared_ptr<NodeType>& to,
-          const int& key,
-          const std::shared_ptr<EdgeData>& data = new EdgeData):
+    _Edge(const _Handle<NodeType>& from,
+          const _Handle<NodeType>& to,
+          const uint64_t& key,
+          const DataPointer& data):
             _EdgeBase<NodeData, EdgeData>(from, to, key) {
         _data = data;
     }
 
 
     EdgeData& data() const {
-        return *_data;
+        return _data->data;
     }
 
 
-    std::shared_ptr<EdgeData> dataPointer() const {
+    DataPointer dataPointer() const {
         return _data;
     }
 
@@ -143,7 +224,7 @@ class _Edge : public _EdgeBase<NodeData, EdgeData> {
     friend class _Node<NodeData, EdgeData>;
     friend class _NodeBase<NodeData, EdgeData>;
 
-    std::shared_ptr<EdgeData> _data;
+    DataPointer _data;
 };
 
 template<class NodeData>
@@ -152,18 +233,14 @@ class _Edge<NodeData, void> : public _EdgeBase<NodeData, void> {
     typedef _Node<NodeData, void> NodeType;
     typedef _Edge<NodeData, void> EdgeType;
 
-    _Edge(const _Edge& that):
-        _EdgeBase<NodeData, void>(that) {
-    }
-
-    _Edge(const std::shared_ptr<NodeType>& from,
-          const std::shared_ptr<NodeType>& to):
+    _Edge(const _Handle<NodeType>& from,
+          const _Handle<NodeType>& to):
         _EdgeBase<NodeData, void>(from, to) {
     }
 
-    _Edge(const std::shared_ptr<NodeType>& from,
-          const std::shared_ptr<NodeType>& to,
-          const int& key):
+    _Edge(const _Handle<NodeType>& from,
+          const _Handle<NodeType>& to,
+          const uint64_t& key):
             _EdgeBase<NodeData, void>(from, to, key) {
     }
 
@@ -184,8 +261,7 @@ template<class NodeData>
 _Edge<NodeData, void> addEdge(const NodeWrapper<NodeData, void> &from,
                               const NodeWrapper<NodeData, void> &to) {
     auto edge = from.addEdge(to);
-    if (from != to)
-        to.addEdge(from, edge.getKey());
+    to.addEdge(from, edge.getKey());
     return edge;
 }
 
@@ -0,0 +1,75 @@
+#ifndef INPUT_GENERATOR_EDGE_SET_HPP_
+#define INPUT_GENERATOR_EDGE_SET_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "exception.hpp"
+#include "flat_set.hpp"
+
+namespace inputGenerator {
+
+/**
+ * Undirected pairs of node indexes, (x, y) and (y, x) are the same
+ * Each pair is packed in 64 bits so it's one probe in a FlatSet, that makes
+ * rejecting duplicate edges cheap even for huge graphs
+ * Indexes must be between 0 and 2^32 - 1
+ */
+class EdgeSet {
+  public:
+    explicit EdgeSet(const size_t &expected = 0): keys_(expected) {
+    }
+
+    // true if the pair was not there before
+    bool insert(const int64_t &from, const int64_t &to) {
+        return keys_.insert(pack(from, to));
+    }
+
+    bool count(const int64_t &from, const int64_t &to) const {
+        return keys_.count(pack(from, to));
+    }
+
+    // true if the pair was there
+    bool erase(const int64_t &from, const int64_t &to) {
+        return keys_.erase(pack(from, to));
+    }
+
+    void reserve(const size_t &expected) {
+        keys_.reserve(expected);
+    }
+
+    void clear() {
+        keys_.clear();
+    }
+
+    size_t size() const {
+        return keys_.size();
+    }
+
+    bool empty() const {
+        return keys_.empty();
+    }
+
+    static uint64_t pack(const int64_t &from, const int64_t &to) {
+#ifdef INPUT_GENERATOR_DEBUG
+        if (from < 0 || to < 0 || from >= kLimit || to >= kLimit)
+            throw Exception("EdgeSet expects indexes between 0 and 2^32 - 1");
+#endif
+        if (from < to)
+            return (static_cast<uint64_t>(from) << 32) |
+                   static_cast<uint64_t>(to);
+        return (static_cast<uint64_t>(to) << 32) |
+               static_cast<uint64_t>(from);
+    }
+
+  private:
+    static const int64_t kLimit = int64_t(1) << 32;
+
+    FlatSet keys_;
+};
+
+const int64_t EdgeSet::kLimit;
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_EDGE_SET_HPP_
@@ -0,0 +1,170 @@
+#ifndef INPUT_GENERATOR_FLAT_SET_HPP_
+#define INPUT_GENERATOR_FLAT_SET_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace inputGenerator {
+
+/**
+ * Open addressing hash set of 64-bit keys, one flat array and linear probing
+ * Erasing shifts the following keys back so there are no tombstones and
+ * lookups stay short no matter how many keys come and go
+ */
+class FlatSet {
+  public:
+    explicit FlatSet(const size_t &expected = 0);
+
+    // true if the key was not there before
+    bool insert(const uint64_t &key);
+
+    bool count(const uint64_t &key) const;
+
+    // true if the key was there
+    bool erase(const uint64_t &key);
+
+    // room for `expected` keys without growing
+    void reserve(const size_t &expected);
+
+    void clear();
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+  private:
+    // marks a free slot, the key itself is kept on the side
+    static const uint64_t kEmpty = ~uint64_t(0);
+
+    static uint64_t hash(uint64_t key) {
+        // splitmix64 finalizer, consecutive keys end up far apart
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return key;
+    }
+
+    size_t find(const uint64_t &key) const;
+
+    void rehash(const size_t &capacity);
+
+    std::vector<uint64_t> slots_;
+    size_t mask_;
+    size_t size_;
+    bool hasEmptyKey_;
+};
+
+const uint64_t FlatSet::kEmpty;
+
+FlatSet::FlatSet(const size_t &expected):
+        mask_(0),
+        size_(0),
+        hasEmptyKey_(false) {
+    if (expected > 0)
+        reserve(expected);
+}
+
+size_t FlatSet::find(const uint64_t &key) const {
+    size_t position = hash(key) & mask_;
+    while (slots_[position] != key && slots_[position] != kEmpty)
+        position = (position + 1) & mask_;
+    return position;
+}
+
+bool FlatSet::insert(const uint64_t &key) {
+    if (key == kEmpty) {
+        if (hasEmptyKey_)
+            return false;
+        hasEmptyKey_ = true;
+        ++size_;
+        return true;
+    }
+
+    // at most 3/4 full
+    if (4 * (size_ + 1) > 3 * slots_.size())
+        rehash(slots_.empty() ? 16 : 2 * slots_.size());
+
+    size_t position = find(key);
+    if (slots_[position] == key)
+        return false;
+    slots_[position] = key;
+    ++size_;
+    return true;
+}
+
+bool FlatSet::count(const uint64_t &key) const {
+    if (key == kEmpty)
+        return hasEmptyKey_;
+    if (slots_.empty())
+        return false;
+    return slots_[find(key)] == key;
+}
+
+bool FlatSet::erase(const uint64_t &key) {
+    if (key == kEmpty) {
+        if (!hasEmptyKey_)
+            return false;
+        hasEmptyKey_ = false;
+        --size_;
+        return true;
+    }
+    if (slots_.empty())
+        return false;
+
+    size_t hole = find(key);
+    if (slots_[hole] != key)
+        return false;
+
+    // every key after the hole that could live in it moves back
+    size_t position = hole;
+    while (true) {
+        position = (position + 1) & mask_;
+        if (slots_[position] == kEmpty)
+            break;
+
+        size_t home = hash(slots_[position]) & mask_;
+        if (((position - home) & mask_) >= ((position - hole) & mask_)) {
+            slots_[hole] = slots_[position];
+            hole = position;
+        }
+    }
+    slots_[hole] = kEmpty;
+    --size_;
+    return true;
+}
+
+void FlatSet::reserve(const size_t &expected) {
+    size_t capacity = 16;
+    while (3 * capacity < 4 * expected)
+        capacity *= 2;
+    if (capacity > slots_.size())
+        rehash(capacity);
+}
+
+void FlatSet::clear() {
+    std::fill(slots_.begin(), slots_.end(), kEmpty);
+    size_ = 0;
+    hasEmptyKey_ = false;
+}
+
+void FlatSet::rehash(const size_t &capacity) {
+    std::vector<uint64_t> old(capacity, kEmpty);
+    old.swap(slots_);
+    mask_ = capacity - 1;
+
+    for (auto &key : old)
+        if (key != kEmpty)
+            slots_[find(key)] = key;
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_FLAT_SET_HPP_
@@ -1,6 +1,7 @@
 #ifndef INPUT_GENERATOR_GENERATOR_HPP_
 #define INPUT_GENERATOR_GENERATOR_HPP_
 
+#include <atomic>
 #include <random>
 
 #include "seed.hpp"
@@ -22,19 +23,37 @@ class Generator {
     void operator=(const Generator&);
 
     // Whether or not the generator has been created
-    static bool created;
+    static thread_local bool created;
 
-    // the generator object itself
-    static std::mt19937 generator;
+    // the generator object itself, one for each thread so graphs can be
+    // generated concurrently
+    static thread_local std::mt19937 generator;
+
+    // the first thread to create a generator gets number 0 and uses the seed
+    // as it is, the others mix in their number
+    static thread_local unsigned thread;
+    static std::atomic<unsigned> threads;
 };
 
-bool Generator::created = false;
+thread_local bool Generator::created = false;
+
+thread_local std::mt19937 Generator::generator;
+
+thread_local unsigned Generator::thread = 0;
 
-std::mt19937 Generator::generator;
+std::atomic<unsigned> Generator::threads(0);
 
 void Generator::create() {
+    if (!created)
+        thread = threads++;
     created = true;
-    generator = std::mt19937(Seed::getSeed());
+
+    if (thread == 0) {
+        generator = std::mt19937(Seed::getSeed());
+    } else {
+        std::seed_seq sequence{Seed::getSeed(), thread};
+        generator = std::mt19937(sequence);
+    }
 }
 
 std::mt19937& Generator::getGenerator() {
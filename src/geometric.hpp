@@ -0,0 +1,369 @@
+#ifndef INPUT_GENERATOR_GEOMETRIC_HPP_
+#define INPUT_GENERATOR_GEOMETRIC_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+#include "attributes.hpp"
+#include "graph.hpp"
+#include "sink.hpp"
+
+namespace inputGenerator {
+
+/**
+ * Random geometric graphs: points in `dimension` dimensions, every two of
+ * them at most `radius` apart joined by an edge
+ * Point i is node i (the one in position i, like in attributes.hpp), random
+ * points come in random order already so nothing gets relabeled
+ * Neighbours are found through a grid of cells at least `radius` wide where
+ * only points in touching cells are compared, O(size + edges) for a fixed
+ * dimension (every cell looks at half of the 3^dimension cells around it)
+ */
+
+// what happens with the components of a geometric graph
+enum class GeometricComponents {
+    kAll,       // they stay as they are
+    kLargest,   // only the largest one stays, the other points are dropped
+    kConnected  // joined by edges between points next to each other in the
+                // order of the grid cells, which are short most of the time
+};
+
+// `size` points, every coordinate uniform in [from, to] for integers and in
+// [from, to) for reals
+template<class Coordinate = double>
+std::vector< std::vector<Coordinate> > randomPoints(const size_t &size,
+                                                    const size_t &dimension,
+                                                    const Coordinate &from = 0,
+                                                    const Coordinate &to = 1) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (dimension == 0)
+        throw Exception("Points need at least one dimension");
+#endif
+    std::vector< std::vector<Coordinate> > points(size);
+    for (auto &point : points)
+        point = help::randomValues<Coordinate>(dimension, from, to);
+    return points;
+}
+
+namespace help {
+    // distances are exact for integer points
+    template<class Coordinate>
+    using GeometricDistance = typename std::conditional<
+        std::is_integral<Coordinate>::value, int64_t, Coordinate>::type;
+
+    template<class Coordinate>
+    void checkPoints(const std::vector< std::vector<Coordinate> > &points,
+                     const double &radius) {
+        if (radius < 0)
+            throw Exception("Geometric graphs need a radius of at least 0");
+        for (auto &point : points)
+            if (point.empty() || point.size() != points[0].size())
+                throw Exception("Geometric graphs need points with the same "
+                                "strictly positive dimension");
+    }
+
+    // every pair of points at most `radius` apart goes to `emit`, the
+    // points in the order of their cells come back
+    template<class Coordinate, class Emit>
+    std::vector<int64_t> geometricEdges(
+            const std::vector< std::vector<Coordinate> > &points,
+            const double &radius, Emit emit) {
+        typedef GeometricDistance<Coordinate> Distance;
+        const int64_t size = points.size();
+        std::vector<int64_t> order(size);
+        if (size == 0)
+            return order;
+        const size_t dimension = points[0].size();
+
+        // the box around the points cut into `cells[d]` slices of width
+        // at least `radius` along dimension d
+        std::vector<double> low(dimension), width(dimension, 0);
+        std::vector<int64_t> cells(dimension, 1);
+        for (size_t d = 0; d < dimension; ++d) {
+            double lowest = points[0][d], highest = points[0][d];
+            for (auto &point : points) {
+                lowest = std::min(lowest, static_cast<double>(point[d]));
+                highest = std::max(highest, static_cast<double>(point[d]));
+            }
+            low[d] = lowest;
+            width[d] = highest - lowest;
+            if (width[d] > radius * size)
+                cells[d] = size;
+            else if (width[d] > radius)
+                cells[d] = static_cast<int64_t>(width[d] / radius);
+        }
+
+        // at most about 2 * size cells, bigger cells still find everything
+        auto total = [&]() {
+            int64_t result = 1;
+            for (auto &count : cells)
+                result = std::min(result * count, 2 * size + 1);
+            return result;
+        };
+        while (total() > 2 * size) {
+            auto biggest = std::max_element(cells.begin(), cells.end());
+            *biggest = (*biggest + 1) / 2;
+        }
+
+        std::vector<int64_t> stride(dimension, 1);
+        for (size_t d = 1; d < dimension; ++d)
+            stride[d] = stride[d - 1] * cells[d - 1];
+        for (size_t d = 0; d < dimension; ++d)
+            width[d] /= cells[d];
+
+        // a counting sort of the points by cell
+        std::vector<int64_t> cell(size), start(total() + 1, 0);
+        for (int64_t i = 0; i < size; ++i) {
+            cell[i] = 0;
+            for (size_t d = 0; d < dimension; ++d) {
+                int64_t slice = 0;
+                if (width[d] > 0)
+                    slice = std::min(cells[d] - 1, static_cast<int64_t>(
+                        (points[i][d] - low[d]) / width[d]));
+                cell[i] += slice * stride[d];
+            }
+            ++start[cell[i] + 1];
+        }
+        for (size_t i = 1; i < start.size(); ++i)
+            start[i] += start[i - 1];
+        std::vector<int64_t> next(start.begin(), start.end() - 1);
+        for (int64_t i = 0; i < size; ++i)
+            order[next[cell[i]]++] = i;
+
+        // the cells around one, the first nonzero step forward so every
+        // pair of touching cells comes up once
+        std::vector< std::vector<int> > steps;
+        std::vector<int> step(dimension, -1);
+        while (true) {
+            size_t first = 0;
+            while (first < dimension && step[first] == 0)
+                ++first;
+            if (first < dimension && step[first] == 1)
+                steps.push_back(step);
+
+            size_t d = 0;
+            while (d < dimension && step[d] == 1)
+                step[d++] = -1;
+            if (d == dimension)
+                break;
+            ++step[d];
+        }
+
+        // the coordinates again in the order of the cells, so the points
+        // of a cell and of the ones after it are close in memory
+        std::vector<Distance> sorted(size * dimension);
+        for (int64_t i = 0; i < size; ++i)
+            for (size_t d = 0; d < dimension; ++d)
+                sorted[i * dimension + d] =
+                    static_cast<Distance>(points[order[i]][d]);
+
+        const Distance squared = static_cast<Distance>(
+            static_cast<long double>(radius) * radius);
+        auto close = [&](const int64_t &first, const int64_t &second) {
+            const Distance *x = &sorted[first * dimension];
+            const Distance *y = &sorted[second * dimension];
+            Distance sum = 0;
+            for (size_t d = 0; d < dimension; ++d) {
+                Distance difference = x[d] - y[d];
+                if (difference < 0)
+                    difference = -difference;
+                if (difference > radius)
+                    return false;
+                sum += difference * difference;
+            }
+            return sum <= squared;
+        };
+
+        std::vector<int64_t> slice(dimension);
+        for (int64_t current = 0; current + 1 < int64_t(start.size());
+             ++current) {
+            if (start[current] == start[current + 1])
+                continue;
+
+            for (int64_t i = start[current]; i < start[current + 1]; ++i)
+                for (int64_t j = i + 1; j < start[current + 1]; ++j)
+                    if (close(i, j))
+                        emit(order[i], order[j]);
+
+            for (size_t d = 0; d < dimension; ++d)
+                slice[d] = current / stride[d] % cells[d];
+            for (auto &around : steps) {
+                int64_t other = current;
+                bool inside = true;
+                for (size_t d = 0; d < dimension && inside; ++d) {
+                    inside = slice[d] + around[d] >= 0 &&
+                             slice[d] + around[d] < cells[d];
+                    other += around[d] * stride[d];
+                }
+                if (!inside)
+                    continue;
+
+                for (int64_t i = start[current]; i < start[current + 1]; ++i)
+                    for (int64_t j = start[other]; j < start[other + 1]; ++j)
+                        if (close(i, j))
+                            emit(order[i], order[j]);
+            }
+        }
+        return order;
+    }
+
+    // the edges after `components` is taken care of, dropped points are
+    // taken out of `points` and the others keep their order
+    template<class Coordinate, class Emit>
+    void geometricComponentEdges(std::vector< std::vector<Coordinate> > &points,
+                                 const double &radius,
+                                 const GeometricComponents &components,
+                                 Emit emit) {
+        if (components == GeometricComponents::kAll) {
+            geometricEdges(points, radius, emit);
+            return;
+        }
+
+        const int64_t size = points.size();
+        std::vector<int64_t> parent(size), count(size, 1);
+        for (int64_t i = 0; i < size; ++i)
+            parent[i] = i;
+
+        auto find = [&parent](int64_t node) {
+            while (parent[node] != node) {
+                parent[node] = parent[parent[node]];
+                node = parent[node];
+            }
+            return node;
+        };
+        auto unite = [&](const int64_t &first, const int64_t &second) {
+            int64_t x = find(first), y = find(second);
+            if (x == y)
+                return false;
+            if (count[x] < count[y])
+                std::swap(x, y);
+            parent[y] = x;
+            count[x] += count[y];
+            return true;
+        };
+
+        if (components == GeometricComponents::kConnected) {
+            auto order = geometricEdges(points, radius,
+                                        [&](const int64_t &first,
+                                            const int64_t &second) {
+                unite(first, second);
+                emit(first, second);
+            });
+            for (int64_t i = 1; i < size; ++i)
+                if (unite(order[i - 1], order[i]))
+                    emit(order[i - 1], order[i]);
+            return;
+        }
+
+        std::vector< std::pair<int64_t, int64_t> > edges;
+        geometricEdges(points, radius,
+                       [&](const int64_t &first, const int64_t &second) {
+            unite(first, second);
+            edges.push_back(std::make_pair(first, second));
+        });
+
+        int64_t largest = -1;
+        for (int64_t i = 0; i < size; ++i)
+            if (parent[i] == i && (largest < 0 || count[i] > count[largest]))
+                largest = i;
+
+        std::vector<int64_t> label(size, -1);
+        int64_t kept = 0;
+        for (int64_t i = 0; i < size; ++i)
+            if (find(i) == largest) {
+                if (kept != i)
+                    points[kept] = std::move(points[i]);
+                label[i] = kept++;
+            }
+        points.resize(kept);
+
+        for (auto &edge : edges)
+            if (label[edge.first] >= 0)
+                emit(label[edge.first], label[edge.second]);
+    }
+}  // namespace help
+
+// node i is points[i]
+template<class NodeData = void, class EdgeData = void, class Coordinate>
+Graph<NodeData, EdgeData> geometricGraph(
+        const std::vector< std::vector<Coordinate> > &points,
+        const double &radius) {
+#ifdef INPUT_GENERATOR_DEBUG
+    help::checkPoints(points, radius);
+#endif
+    Graph<NodeData, EdgeData> graph(points.size());
+    help::geometricEdges(points, radius,
+                         [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+    return graph;
+}
+
+template<class Coordinate, class Sink>
+void geometricGraph(const std::vector< std::vector<Coordinate> > &points,
+                    const double &radius, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    help::checkPoints(points, radius);
+#endif
+    help::geometricEdges(points, radius,
+                         [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
+
+// `size` random points (see randomPoints) and the graph on them, with fewer
+// points if only the largest component is kept
+// integer `from` and `to` put the points on a grid
+template<class Coordinate = double, class NodeData = void,
+         class EdgeData = void>
+std::pair<Graph<NodeData, EdgeData>, std::vector< std::vector<Coordinate> > >
+geometricGraph(const size_t &size, const double &radius,
+               const size_t &dimension = 2,
+               const GeometricComponents &components = GeometricComponents::kAll,
+               const Coordinate &from = 0, const Coordinate &to = 1) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (radius < 0)
+        throw Exception("Geometric graphs need a radius of at least 0");
+#endif
+    auto points = randomPoints<Coordinate>(size, dimension, from, to);
+    std::vector< std::pair<int64_t, int64_t> > edges;
+    help::geometricComponentEdges(points, radius, components,
+                                  [&](const int64_t &first,
+                                      const int64_t &second) {
+        edges.push_back(std::make_pair(first, second));
+    });
+
+    Graph<NodeData, EdgeData> graph(points.size());
+    for (auto &edge : edges)
+        addEdge(graph[edge.first], graph[edge.second]);
+    return std::make_pair(graph, points);
+}
+
+// the edges go to `sink` and the points come back
+template<class Coordinate, class Sink>
+std::vector< std::vector<Coordinate> > geometricGraph(
+        const size_t &size, const double &radius, const size_t &dimension,
+        const GeometricComponents &components, const Coordinate &from,
+        const Coordinate &to, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (radius < 0)
+        throw Exception("Geometric graphs need a radius of at least 0");
+#endif
+    auto points = randomPoints<Coordinate>(size, dimension, from, to);
+    help::geometricComponentEdges(points, radius, components,
+                                  [&](const int64_t &first,
+                                      const int64_t &second) {
+        emitEdge(sink, first, second);
+    });
+    return points;
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_GEOMETRIC_HPP_
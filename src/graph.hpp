@@ -1,14 +1,20 @@
 #ifndef INPUT_GENERATOR_GRAPH_HPP_
 #define INPUT_GENERATOR_GRAPH_HPP_
 
-#include <unordered_set>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <utility>
 #include <algorithm>
 
+#include "arena.hpp"
 #include "exception.hpp"
+#include "handle.hpp"
 #include "node.hpp"
 #include "edge.hpp"
+#include "edge_set.hpp"
+#include "range.hpp"
+#include "sink.hpp"
 #include "vectors.hpp"
 
 namespace inputGenerator {
@@ -24,7 +30,7 @@ class Graph {
     template<class VectorIteratorType>
     class Iterator {
       public:
-        typedef int difference_type;
+        typedef std::ptrdiff_t difference_type;
         typedef Node value_type;
         typedef typename VectorIteratorType::value_type pointer;
         typedef typename VectorIteratorType::reference reference;
@@ -91,7 +97,94 @@ class Graph {
     typedef Iterator<typename std::vector<Node>::iterator> iterator;
     typedef Iterator<typename std::vector<Node>::const_iterator> const_iterator;
 
-    Graph(const int& _size = 1, const int& _indexStart = 0);
+    // goes through the adjacency of every node in order, each edge is seen
+    // once (from the end with the smaller index) and arcs from their source
+    class EdgeIterator {
+      public:
+        typedef std::ptrdiff_t difference_type;
+        typedef EdgeType value_type;
+        typedef const EdgeType* pointer;
+        typedef const EdgeType& reference;
+        typedef std::forward_iterator_tag iterator_category;
+
+        EdgeIterator(): graph_(nullptr), node_(0) {
+        }
+
+        reference operator*() const {
+            return *adjacency_;
+        }
+
+        pointer operator->() const {
+            return &*adjacency_;
+        }
+
+        EdgeIterator& operator++() {
+            ++adjacency_;
+            settle();
+            return *this;
+        }
+
+        EdgeIterator operator++(int) {
+            EdgeIterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const EdgeIterator& that) const {
+            return node_ == that.node_ &&
+                   (node_ == graph_->nodes.size() ||
+                    adjacency_ == that.adjacency_);
+        }
+
+        bool operator!=(const EdgeIterator& that) const {
+            return !(*this == that);
+        }
+
+      private:
+        friend class Graph<NodeData, EdgeData>;
+
+        typedef _AdjacencyIterator<NodeData, EdgeData> AdjacencyIterator;
+
+        EdgeIterator(const Graph<NodeData, EdgeData> *graph,
+                     const size_t &node,
+                     const typename AdjacencyIterator::Kind &kind):
+                graph_(graph),
+                node_(node),
+                kind_(kind) {
+            if (node_ < graph_->nodes.size()) {
+                open();
+                settle();
+            }
+        }
+
+        void open() {
+            adjacency_ = AdjacencyIterator::begin(
+                    *graph_->nodes[node_].internalNode, kind_);
+        }
+
+        // moves to the next thing we should stop on
+        void settle() {
+            while (node_ < graph_->nodes.size()) {
+                if (adjacency_.atEnd()) {
+                    if (++node_ < graph_->nodes.size())
+                        open();
+                    continue;
+                }
+
+                if (kind_ != AdjacencyIterator::kEdges ||
+                        graph_->ownsEdge(*adjacency_))
+                    return;
+                ++adjacency_;
+            }
+        }
+
+        const Graph<NodeData, EdgeData> *graph_;
+        size_t node_;
+        typename AdjacencyIterator::Kind kind_;
+        AdjacencyIterator adjacency_;
+    };
+
+    Graph(const int64_t& _size = 1, const int64_t& _indexStart = 0);
 
     // shallow copy
     Graph(const Graph&) = default;
@@ -109,15 +202,42 @@ class Graph {
     // and some deep copy
     Graph<NodeData, EdgeData> clone() const;
 
+    // if nothing else uses our memory it's kept for the next nodes
     void clear();
 
-    void Index(std::initializer_list< std::pair<Node, int> > fixed,
-               const int &from = 0);
+    // same as a brand new graph but reusing the memory of this one
+    void reset(const int64_t& _size = 1, const int64_t& _indexStart = 0);
+
+    void Index(std::initializer_list< std::pair<Node, int64_t> > fixed,
+               const int64_t &from = 0);
+
+    void Index(const int64_t &from = 0);
 
-    void Index(const int &from = 0);
+    // works out the same indexes as Index() but leaves the nodes alone,
+    // label() tells what a node will be and applyIndex() moves them there
+    // (adding nodes applies it first)
+    void deferIndex(std::initializer_list< std::pair<Node, int64_t> > fixed,
+                    const int64_t &from = 0);
+
+    void deferIndex(const int64_t &from = 0);
+
+    void applyIndex();
+
+    // the index a node indexed `index` gets once the deferred Index is
+    // applied, `index` itself if there is none
+    int64_t label(const int64_t &index) const {
+        return hasPendingIndex ? pendingIndex[index - indexStart] : index;
+    }
+
+    // every node keeps its adjacency sorted by index (see
+    // NodeWrapper::sortedAdjacency), Index() sorts them again
+    void sortAdjacency();
 
     void addNodes(std::initializer_list<Node>);
 
+    // adds `count` new nodes indexed after the existing ones
+    void addNodes(const size_t &count);
+
     void mergeGraph(const Graph<NodeData, EdgeData> &);
 
     iterator begin() {
@@ -136,7 +256,7 @@ class Graph {
         return const_iterator(nodes.end());
     }
 
-    Node& operator[](const int &position) {
+    Node& operator[](const int64_t &position) {
 #ifdef INPUT_GENERATOR_DEBUG
         if (position < indexStart || position >= indexStart + size())
             throw Exception("index out of range in the graph");
@@ -144,7 +264,7 @@ class Graph {
         return nodes[position - indexStart];
     }
 
-    const Node& operator[](const int &position) const {
+    const Node& operator[](const int64_t &position) const {
 #ifdef INPUT_GENERATOR_DEBUG
         if (position < indexStart || position >= indexStart + size())
             throw Exception("index out of range in the graph");
@@ -152,7 +272,7 @@ class Graph {
         return nodes[position - indexStart];
     }
 
-    int size() const {
+    int64_t size() const {
         return nodes.size();
     }
 
@@ -160,6 +280,30 @@ class Graph {
 
     std::vector<EdgeType> edges(const bool &forceSearch = true) const;
 
+    // the same as edges() and arcs() without building anything
+    // don't add or erase edges while going through them
+    Range<EdgeIterator> edgeRange() const {
+        return range(_AdjacencyIterator<NodeData, EdgeData>::kEdges);
+    }
+
+    Range<EdgeIterator> arcRange() const {
+        return range(_AdjacencyIterator<NodeData, EdgeData>::kArcs);
+    }
+
+    // the part of edgeRange() that comes from the nodes in positions
+    // [first, last), consecutive pieces put back together give all of it
+    Range<EdgeIterator> edgeRange(const size_t &first,
+                                  const size_t &last) const {
+        typedef _AdjacencyIterator<NodeData, EdgeData> Adjacency;
+        return Range<EdgeIterator>(
+            EdgeIterator(this, std::min(first, nodes.size()), Adjacency::kEdges),
+            EdgeIterator(this, std::min(last, nodes.size()), Adjacency::kEdges));
+    }
+
+    // the pairs of nodes joined by an edge or an arc (in any direction),
+    // for O(1) checks of whether two nodes are adjacent
+    EdgeSet edgeSet() const;
+
     void expandNode(const Node&, const Graph<NodeData, EdgeData>&);
 
     void expandNode(const Node&, const Graph<NodeData, EdgeData>&, const std::vector<Node>&);
@@ -172,30 +316,71 @@ class Graph {
 
     void fuseGraph(Graph<NodeData, EdgeData>&, std::initializer_list< std::pair<Node, Node> >, Boolean::Object simpleGraph = Boolean::False);
 
-    void fuseGraph(Graph<NodeData, EdgeData>&, int atLeast = 0, Boolean::Object simpleGraph = Boolean::False);
+    void fuseGraph(Graph<NodeData, EdgeData>&, int64_t atLeast = 0, Boolean::Object simpleGraph = Boolean::False);
 
     bool hasNode(const Node&) const;
 
-    int min() const {
+    int64_t min() const {
         return indexStart;
     }
 
-    int max() const {
+    int64_t max() const {
         return indexStart + size() - 1;
     }
 
   protected:
+    // the labels Index(fixed, from) gives, by position
+    Relabeling relabeling(
+            std::initializer_list< std::pair<Node, int64_t> > fixed,
+            const int64_t &from) const;
+
+    // moves every node to its label
+    void relabel(const Relabeling &labels);
+
+    Range<EdgeIterator> range(
+            const typename _AdjacencyIterator<NodeData, EdgeData>::Kind &kind)
+            const {
+        return Range<EdgeIterator>(EdgeIterator(this, 0, kind),
+                                   EdgeIterator(this, nodes.size(), kind));
+    }
+
+    // whether this is the copy of the edge edges() should give
+    // the one in the smaller node, unless the other end is not ours
+    bool ownsEdge(const EdgeType &edge) const {
+        const NodeType *to = edge._to.get();
+        int64_t position = to->index - indexStart;
+        if (position < 0 || position >= size() ||
+                nodes[position].internalNode.get() != to)
+            return true;
+        return edge.fromIndex() <= to->index;
+    }
+
+    // a node whose adjacency lives in our arena
+    Node newNode(const int64_t &index) const {
+        return Node(_makeHandle<NodeType>(arena.get(), index, arena.get()));
+    }
+
     std::vector<Node> nodes;
 
-    int indexStart;
+    int64_t indexStart;
+
+    // shared by the shallow copies, nodes and edge data keep it alive
+    _Handle<Arena> arena;
+
+    // from deferIndex, not applied yet
+    Relabeling pendingIndex;
+    bool hasPendingIndex;
 };
 
 template<class NodeData, class EdgeData>
-Graph<NodeData, EdgeData>::Graph(const int& _size, const int& _indexStart) {
+Graph<NodeData, EdgeData>::Graph(const int64_t& _size,
+                                 const int64_t& _indexStart):
+        arena(new Arena()),
+        hasPendingIndex(false) {
     // we create _size new nodes
     nodes.reserve(_size);
-    for (int i = 0; i < _size; ++i)
-        nodes.push_back(Node(i));
+    for (int64_t i = 0; i < _size; ++i)
+        nodes.push_back(newNode(_indexStart + i));
 
     // make it so it supports both possibilities
     // nodes from 0 to size - 1 or from 1 to size or etc
@@ -203,9 +388,13 @@ Graph<NodeData, EdgeData>::Graph(const int& _size, const int& _indexStart) {
 }
 
 template<class NodeData, class EdgeData>
-Graph<NodeData, EdgeData>::Graph(Graph<NodeData, EdgeData> &&graph) {
+Graph<NodeData, EdgeData>::Graph(Graph<NodeData, EdgeData> &&graph):
+        hasPendingIndex(false) {
     std::swap(nodes, graph.nodes);
     std::swap(indexStart, graph.indexStart);
+    std::swap(arena, graph.arena);
+    std::swap(pendingIndex, graph.pendingIndex);
+    std::swap(hasPendingIndex, graph.hasPendingIndex);
 }
 
 template<class NodeData, class EdgeData>
@@ -213,6 +402,9 @@ Graph<NodeData, EdgeData>& Graph<NodeData, EdgeData>::operator=(
         Graph<NodeData, EdgeData> &&graph) {
     std::swap(nodes, graph.nodes);
     std::swap(indexStart, graph.indexStart);
+    std::swap(arena, graph.arena);
+    std::swap(pendingIndex, graph.pendingIndex);
+    std::swap(hasPendingIndex, graph.hasPendingIndex);
     return *this;
 }
 
@@ -220,15 +412,15 @@ template<class NodeData, class EdgeData>
 Graph<NodeData, EdgeData> Graph<NodeData, EdgeData>::clone() const {
     Graph<NodeData, EdgeData> newGraph(size(), indexStart);
 
-    for (auto &arc : arcs(true)) {
-        newGraph[arc.from().index()].addEdge(newGraph[arc.to().index()],
-                                             arc.data());
+    for (auto &arc : arcRange()) {
+        newGraph[arc.fromIndex()].addEdge(newGraph[arc.toIndex()],
+                                          arc.data());
     }
 
-    for (auto &edge : edges(true))
-        auto edge2 = addEdge(newGraph[edge.from().index()],
-                             newGraph[edge.to().index()],
-                             edge.data());
+    for (auto &edge : edgeRange())
+        addEdge(newGraph[edge.fromIndex()],
+                newGraph[edge.toIndex()],
+                edge.data());
 
     return newGraph;
 }
@@ -236,12 +428,12 @@ Graph<NodeData, EdgeData> Graph<NodeData, EdgeData>::clone() const {
 template<class NodeData>
 Graph<NodeData, void> cloneGraph(const Graph<NodeData, void>& graph) {
     Graph<NodeData, void> newGraph(graph.size(), graph.min());
-    for (auto &arc : graph.arcs(true)) {
-        newGraph[arc.from().index()].addEdge(newGraph[arc.to().index()]);
+    for (auto &arc : graph.arcRange()) {
+        newGraph[arc.fromIndex()].addEdge(newGraph[arc.toIndex()]);
     }
 
-    for (auto &edge: graph.edges(true))
-        auto edge2 = addEdge(newGraph[edge.from().index()], newGraph[edge.to().index()]);
+    for (auto &edge : graph.edgeRange())
+        addEdge(newGraph[edge.fromIndex()], newGraph[edge.toIndex()]);
 
     return newGraph;
 }
@@ -249,79 +441,165 @@ Graph<NodeData, void> cloneGraph(const Graph<NodeData, void>& graph) {
 
 template<class NodeData, class EdgeData>
 void Graph<NodeData, EdgeData>::clear() {
-    std::vector<Node>().swap(nodes);
+    nodes.clear();
+    pendingIndex = Relabeling();
+    hasPendingIndex = false;
+
+    // nodes or edge data still held by someone keep the old arena alive
+    // otherwise we just rewind it, no memory goes back to malloc
+    if (arena && arena.useCount() == 1)
+        arena->reset();
+    else
+        arena = _Handle<Arena>(new Arena());
 }
 
 template<class NodeData, class EdgeData>
-void Graph<NodeData, EdgeData>::Index(
-        std::initializer_list< std::pair<Node, int> > fixed,
-        const int &from) {
-    // we go through each fixed node and keep track of it
-    std::unordered_set<NodeType*> fixedNodes;
-    // we also keep track of the values we have so we can assign demn easily
-    std::unordered_set<int> usedValues;
-    for (auto &node : fixed) {
+void Graph<NodeData, EdgeData>::reset(const int64_t& _size,
+                                      const int64_t& _indexStart) {
+    clear();
+    indexStart = _indexStart;
+    addNodes(_size);
+}
+
+template<class NodeData, class EdgeData>
+Relabeling Graph<NodeData, EdgeData>::relabeling(
+        std::initializer_list< std::pair<Node, int64_t> > fixed,
+        const int64_t &from) const {
+    if (fixed.size() == 0)
+        return Relabeling(size(), Boolean::True, from);
+
+    // we tell the fixed nodes apart by their position, so for a moment
+    // that's what their index is
+    std::vector<int64_t> oldIndexes(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        oldIndexes[i] = nodes[i].index();
+        nodes[i].index() = i;
+    }
+
+    std::vector< std::pair<int64_t, int64_t> > positions;
+    positions.reserve(fixed.size());
+    for (auto &node : fixed)
+        positions.emplace_back(node.first.index(), node.second);
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+        nodes[i].index() = oldIndexes[i];
+
 #ifdef INPUT_GENERATOR_DEBUG
-        if (node.second < from ||
-            node.second >= from + static_cast<int>(nodes.size()))
+    std::vector<bool> fixedNode(nodes.size(), false);
+    std::vector<bool> usedValue(nodes.size(), false);
+    auto node = fixed.begin();
+    for (auto &position : positions) {
+        if (position.first < 0 || position.first >= size() ||
+                nodes[position.first] != node->first)
+            throw Exception("On Graph Reindexing fixed nodes must be from the "
+                            "graph");
+        ++node;
+
+        if (position.second < from || position.second >= from + size())
             throw Exception("On Graph Reindexing nodes must be reindexed using "
                             "only values between `from` and `from` + the_number"
                             "_of_nodes - 1");
 
         // why would you give a node twice?
-        // anyway we ignore following attempts
-        // it's your duty to not have multiple such actions
-        if (fixedNodes.find(node.first.internalNode.get()) != fixedNodes.end())
+        if (fixedNode[position.first])
             throw Exception("On Graph Reindexing no node is allowed to appear "
                             "twice");
 
         // and why would you reuse values?
-        // again we ignore such attempts
-        if (usedValues.find(node.second) != usedValues.end())
+        if (usedValue[position.second - from])
             throw Exception("On Graph Reindexing no two nodes are allowed to ha"
                             "ve the same index");
-#endif
-        node.first.index() = node.second;
-        fixedNodes.insert(node.first.internalNode.get());
-        usedValues.insert(node.second);
-    }
 
-    std::vector<int> unusedValues;
-    unusedValues.reserve(nodes.size() - usedValues.size());
-    for (int i = from; i < from + static_cast<int>(nodes.size()); ++i)
-        if (usedValues.find(i) == usedValues.end())
-            unusedValues.push_back(i);
-    unusedValues = shuffle(unusedValues);
+        fixedNode[position.first] = true;
+        usedValue[position.second - from] = true;
+    }
+#endif
 
-    for (auto &node : nodes) {
-        if (fixedNodes.find(node.internalNode.get()) != fixedNodes.end())
-            continue;
+    return Relabeling(size(), positions, from);
+}
 
-        node.index() = unusedValues.back();
-        unusedValues.pop_back();
+template<class NodeData, class EdgeData>
+void Graph<NodeData, EdgeData>::relabel(const Relabeling &labels) {
+    // every label is taken exactly once, so we just scatter the nodes
+    std::vector<Node> relabeled(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].index() = labels[i];
+        relabeled[labels[i] - labels.from()] = nodes[i];
     }
 
-    // let's reorder the nodes by this index
-    sort(nodes.begin(), nodes.end(), [](const Node &first, const Node &second) {
-        return first.index() < second.index();
-    });
+    nodes.swap(relabeled);
+    indexStart = labels.from();
 
-    indexStart = from;
+    for (auto &node : nodes)
+        node.internalNode->resortAdjacency();
 }
 
 template<class NodeData, class EdgeData>
-void Graph<NodeData, EdgeData>::Index(const int &from) {
+void Graph<NodeData, EdgeData>::Index(
+        std::initializer_list< std::pair<Node, int64_t> > fixed,
+        const int64_t &from) {
+    pendingIndex = Relabeling();
+    hasPendingIndex = false;
+
+    relabel(relabeling(fixed, from));
+}
+
+template<class NodeData, class EdgeData>
+void Graph<NodeData, EdgeData>::Index(const int64_t &from) {
     return Index({}, from);
 }
 
+template<class NodeData, class EdgeData>
+void Graph<NodeData, EdgeData>::deferIndex(
+        std::initializer_list< std::pair<Node, int64_t> > fixed,
+        const int64_t &from) {
+    pendingIndex = relabeling(fixed, from);
+    hasPendingIndex = true;
+}
+
+template<class NodeData, class EdgeData>
+void Graph<NodeData, EdgeData>::deferIndex(const int64_t &from) {
+    return deferIndex({}, from);
+}
+
+template<class NodeData, class EdgeData>
+void Graph<NodeData, EdgeData>::applyIndex() {
+    if (!hasPendingIndex)
+        return;
+
+    relabel(pendingIndex);
+    pendingIndex = Relabeling();
+    hasPendingIndex = false;
+}
+
+template<class NodeData, class EdgeData>
+void Graph<NodeData, EdgeData>::sortAdjacency() {
+    for (auto &node : nodes)
+        node.sortAdjacency();
+}
+
 template<class NodeData, class EdgeData>
 void Graph<NodeData, EdgeData>::addNodes(std::initializer_list<Node> newNodes) {
-    int newIndex = indexStart + nodes.size();
+    applyIndex();
+
+    int64_t newIndex = indexStart + nodes.size();
     for (auto &node : newNodes)
         node.index() = newIndex++;
     nodes.insert(nodes.end(), newNodes.begin(), newNodes.end());
 }
 
+template<class NodeData, class EdgeData>
+void Graph<NodeData, EdgeData>::addNodes(const size_t &count) {
+    if (!arena)
+        arena = _Handle<Arena>(new Arena());
+    applyIndex();
+
+    int64_t newIndex = indexStart + nodes.size();
+    nodes.reserve(nodes.size() + count);
+    for (size_t i = 0; i < count; ++i)
+        nodes.push_back(newNode(newIndex++));
+}
+
 template<class NodeData, class EdgeData>
 void Graph<NodeData, EdgeData>::mergeGraph(
         const Graph<NodeData, EdgeData> &that) {
@@ -333,6 +611,12 @@ template<class NodeData, class EdgeData>
 std::vector<_Edge<NodeData, EdgeData>> Graph<NodeData, EdgeData>::arcs(
         const bool& forceSearch) const {
     std::vector<_Edge<NodeData, EdgeData>> result;
+    if (forceSearch) {
+        for (auto &arc : arcRange())
+            result.push_back(arc);
+        return result;
+    }
+
     for (auto &node : nodes) {
         auto toAdd = node.arcs(forceSearch);
 
@@ -345,6 +629,12 @@ template<class NodeData, class EdgeData>
 std::vector<_Edge<NodeData, EdgeData>> Graph<NodeData, EdgeData>::edges(
         const bool& forceSearch) const {
     std::vector<_Edge<NodeData, EdgeData>> result;
+    if (forceSearch) {
+        for (auto &edge : edgeRange())
+            result.push_back(edge);
+        return result;
+    }
+
     for (auto &node : nodes) {
         auto toAdd = node.edges(forceSearch);
 
@@ -360,10 +650,19 @@ std::vector<_Edge<NodeData, EdgeData>> Graph<NodeData, EdgeData>::edges(
     return result;
 }
 
+template<class NodeData, class EdgeData>
+EdgeSet Graph<NodeData, EdgeData>::edgeSet() const {
+    EdgeSet result;
+    for (auto &node : nodes)
+        for (auto &edge : node.adjacency())
+            result.insert(edge.fromIndex(), edge.toIndex());
+    return result;
+}
+
 template<class NodeData, class EdgeData>
 bool Graph<NodeData, EdgeData>::hasNode(const Node& that) const {
     if (that.index() < indexStart ||
-        that.index() >= indexStart + static_cast<int>(nodes.size()))
+        that.index() >= indexStart + size())
         return false;
 
     return (*this)[that.index()] == that;
@@ -464,27 +763,49 @@ void Graph<NodeData, EdgeData>::fuseGraph(Graph<NodeData, EdgeData>& graph,
         whom[p.second.index()] = p.first;
     }
 
-    for (auto &p : mapping)
-        for (auto &e : p.second.edges()) {
-            if (!graph.hasNode(e.to()))
+    // for a simple graph, the pairs of fused nodes that are already adjacent
+    EdgeSet adjacent;
+    if (simpleGraph)
+        for (auto &p : mapping)
+            for (auto &e : p.first.adjacency())
+                adjacent.insert(e.fromIndex(), e.toIndex());
+
+    for (auto &p : mapping) {
+        auto adjacency = p.second.adjacency();
+        for (auto it = adjacency.begin(); it != adjacency.end(); ) {
+            const EdgeType &e = *it;
+            if (!graph.hasNode(e.to())) {
+                ++it;
                 continue;
+            }
 
             // special case, when we have to fuse the edge between two fused nodes
-            if (special[e.to().index()]) {
-                if (e.from().index() > e.to().index())
+            if (special[e.toIndex()]) {
+                if (e.fromIndex() > e.toIndex()) {
+                    ++it;
                     continue;
+                }
                 using namespace help;
-                if (!simpleGraph || !p.first.hasEdge(whom[e.to().index()]))
-                    addEdge(p.first, whom[e.to().index()], e);
-                eraseEdge(e);
-                continue;
+                const Node &other = whom[e.toIndex()];
+                if (!simpleGraph ||
+                        adjacent.insert(p.first.index(), other.index()))
+                    addEdge(p.first, other, e);
+            } else {
+                using namespace help;
+                addEdge(p.first, e.to(), e);
             }
 
-            using namespace help;
-            addEdge(p.first, e.to(), e);
-            eraseEdge(e);
+            // only this copy of the edge goes away under our iterator
+            auto next = it;
+            ++next;
+            EdgeType erased = e;
+            if (erased.to() != p.second)
+                erased.to().eraseEdge(erased);
+            p.second.eraseEdge(erased);
+            it = next;
         }
-    for (int i = 0; i < graph.size(); ++i)
+    }
+    for (int64_t i = 0; i < graph.size(); ++i)
         if (!special[i])
             addNodes({graph[i]});
 }
@@ -497,16 +818,16 @@ void Graph<NodeData, EdgeData>::fuseGraph(Graph<NodeData, EdgeData>& graph,
 }
 
 template<class NodeData, class EdgeData>
-void Graph<NodeData, EdgeData>::fuseGraph(Graph<NodeData, EdgeData>& graph, int atLeast, Boolean::Object simpleGraph) {
-    int maximum = std::min(size(), graph.size());
+void Graph<NodeData, EdgeData>::fuseGraph(Graph<NodeData, EdgeData>& graph, int64_t atLeast, Boolean::Object simpleGraph) {
+    int64_t maximum = std::min(size(), graph.size());
 
-    int pick = randomInt(atLeast, maximum);
-    auto left = shuffle(randomSubsequence(*this), pick);
-    auto right = shuffle(randomSubsequence(graph), pick);
+    int64_t pick = randomInt(atLeast, maximum);
+    auto left = shuffle(randomSubsequence(nodes, pick));
+    auto right = shuffle(randomSubsequence(graph.nodes, pick));
 
     std::vector< std::pair<Node, Node> > mapping;
     mapping.reserve(pick);
-    for (int i = 0; i < pick; ++i)
+    for (int64_t i = 0; i < pick; ++i)
         mapping.emplace_back(left[i], right[i]);
     fuseGraph(graph, mapping, simpleGraph);
 }
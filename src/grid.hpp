@@ -0,0 +1,595 @@
+#ifndef INPUT_GENERATOR_GRID_HPP_
+#define INPUT_GENERATOR_GRID_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <ostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+#include "boolean.hpp"
+#include "generator.hpp"
+#include "graph.hpp"
+#include "numbers.hpp"
+#include "sink.hpp"
+#include "vectors.hpp"
+
+namespace inputGenerator {
+
+/**
+ * Grids of rows x columns cells, as graphs or as characters ('#' for a wall
+ * or an obstacle, '.' for an open cell)
+ * Cell (i, j) is node i * columns + j and nothing gets relabeled, so a node
+ * tells where its cell is (Index() gives random labels)
+ * Mazes are spanning trees of a grid of rooms, with some of the other walls
+ * opened too for mazes with loops; as characters the rooms are the cells
+ * with both coordinates odd and walls go all around
+ * Everything is O(rows * columns) but Wilson's mazes, which take as long as
+ * their random walks
+ */
+
+// rows x columns characters in one block, row i starts at i * columns
+class CharMatrix {
+  public:
+    CharMatrix(const size_t &rows, const size_t &columns,
+               const char &fill = '.'):
+            rows_(rows),
+            columns_(columns),
+            data_(rows * columns, fill) {
+    }
+
+    size_t rows() const {
+        return rows_;
+    }
+
+    size_t columns() const {
+        return columns_;
+    }
+
+    char& operator()(const size_t &row, const size_t &column) {
+        return data_[row * columns_ + column];
+    }
+
+    const char& operator()(const size_t &row, const size_t &column) const {
+        return data_[row * columns_ + column];
+    }
+
+    // the rows one after the other, no newlines
+    const std::string& data() const {
+        return data_;
+    }
+
+    std::string row(const size_t &row) const {
+        return data_.substr(row * columns_, columns_);
+    }
+
+  private:
+    size_t rows_, columns_;
+    std::string data_;
+};
+
+// a line for every row
+std::ostream& operator<<(std::ostream &stream, const CharMatrix &matrix) {
+    for (size_t row = 0; row < matrix.rows(); ++row)
+        stream.write(matrix.data().data() + row * matrix.columns(),
+                     matrix.columns()) << '\n';
+    return stream;
+}
+
+enum class MazeAlgorithm {
+    // the walls opened in random order, always O(rows * columns) but the
+    // union-find jumps all over memory
+    kKruskal,
+    // uniform among all the mazes, loop-erased random walks that stay close
+    // in memory so it's faster on square grids, but the walks get long
+    // (quadratic) on long thin ones
+    kWilson
+};
+
+namespace help {
+    // the edges between neighbouring cells that are both open, each once
+    template<class Open, class Emit>
+    void gridEdges(const int64_t &rows, const int64_t &columns,
+                   const bool &diagonals, Open open, Emit emit) {
+        for (int64_t i = 0; i < rows; ++i)
+            for (int64_t j = 0; j < columns; ++j) {
+                const int64_t cell = i * columns + j;
+                if (!open(cell))
+                    continue;
+                if (j + 1 < columns && open(cell + 1))
+                    emit(cell, cell + 1);
+                if (i + 1 == rows)
+                    continue;
+                if (diagonals && j > 0 && open(cell + columns - 1))
+                    emit(cell, cell + columns - 1);
+                if (open(cell + columns))
+                    emit(cell, cell + columns);
+                if (diagonals && j + 1 < columns && open(cell + columns + 1))
+                    emit(cell, cell + columns + 1);
+            }
+    }
+
+    // what a room of a maze has open, the walls on its left and above
+    // belong to the rooms there
+    const char kRightOpen = 1, kDownOpen = 2;
+
+    // randomized Kruskal: the walls in random order, each one opened if the
+    // rooms on its sides are not joined yet
+    inline std::vector<char> kruskalMaze(const int64_t &rows,
+                                         const int64_t &columns) {
+        const int64_t rooms = rows * columns;
+        // wall 2 * room is on the right of the room, 2 * room + 1 below it
+        std::vector<uint32_t> walls;
+        walls.reserve(2 * rooms);
+        for (int64_t room = 0; room < rooms; ++room) {
+            if (room % columns + 1 < columns)
+                walls.push_back(2 * room);
+            if (room + columns < rooms)
+                walls.push_back(2 * room + 1);
+        }
+
+        // union by rank, ranks stay below 32 so a byte is enough
+        std::vector<uint32_t> parent(rooms);
+        std::vector<unsigned char> rank(rooms, 0);
+        for (int64_t room = 0; room < rooms; ++room)
+            parent[room] = room;
+        auto find = [&parent](uint32_t room) {
+            while (parent[room] != room) {
+                parent[room] = parent[parent[room]];
+                room = parent[room];
+            }
+            return room;
+        };
+
+        std::vector<char> passages(rooms, 0);
+        auto &generator = Generator::getGenerator();
+        std::uniform_int_distribution<size_t> distribution;
+        typedef std::uniform_int_distribution<size_t>::param_type Range;
+        // drawn one at a time out of the ones left, as in a shuffle
+        for (size_t left = walls.size(); left > 0; --left) {
+            size_t pick = distribution(generator, Range(0, left - 1));
+            const uint32_t wall = walls[pick];
+            walls[pick] = walls[left - 1];
+
+            const int64_t room = wall / 2;
+            const bool down = wall % 2;
+            uint32_t x = find(room), y = find(down ? room + columns : room + 1);
+            if (x == y)
+                continue;
+            if (rank[x] > rank[y])
+                std::swap(x, y);
+            parent[x] = y;
+            if (rank[x] == rank[y])
+                ++rank[y];
+            passages[room] |= down ? kDownOpen : kRightOpen;
+        }
+        return passages;
+    }
+
+    // Wilson: a loop-erased random walk from every room that's not in the
+    // maze yet, up to the first room that is
+    inline std::vector<char> wilsonMaze(const int64_t &rows,
+                                        const int64_t &columns) {
+        const int64_t rooms = rows * columns;
+        // 0 right, 1 down, 2 left, 3 up, -1 for a wall of the grid
+        auto step = [&](const int64_t &room, const int &direction) {
+            switch (direction) {
+                case 0:
+                    return room % columns + 1 < columns ? room + 1 : -1;
+                case 1:
+                    return room + columns < rooms ? room + columns : -1;
+                case 2:
+                    return room % columns > 0 ? room - 1 : -1;
+                default:
+                    return room >= columns ? room - columns : -1;
+            }
+        };
+
+        // 16 directions out of every number the generator gives
+        auto &generator = Generator::getGenerator();
+        uint32_t bits = 0;
+        int bitsLeft = 0;
+        auto randomDirection = [&]() {
+            if (bitsLeft == 0) {
+                bits = generator();
+                bitsLeft = 16;
+            }
+            --bitsLeft;
+            int direction = bits & 3;
+            bits >>= 2;
+            return direction;
+        };
+
+        std::vector<char> passages(rooms, 0), inMaze(rooms, 0), leave(rooms);
+        inMaze[randomInt<int64_t>(0, rooms - 1)] = 1;
+        for (int64_t start = 0; start < rooms; ++start) {
+            // a later visit to a room overwrites the way out of it, which
+            // erases the loop
+            int64_t room = start;
+            while (!inMaze[room]) {
+                int direction;
+                int64_t next;
+                do {
+                    direction = randomDirection();
+                    next = step(room, direction);
+                } while (next < 0);
+                leave[room] = direction;
+                room = next;
+            }
+
+            for (room = start; !inMaze[room]; ) {
+                inMaze[room] = 1;
+                const int64_t next = step(room, leave[room]);
+                switch (leave[room]) {
+                    case 0:
+                        passages[room] |= kRightOpen;
+                        break;
+                    case 1:
+                        passages[room] |= kDownOpen;
+                        break;
+                    case 2:
+                        passages[next] |= kRightOpen;
+                        break;
+                    default:
+                        passages[next] |= kDownOpen;
+                }
+                room = next;
+            }
+        }
+        return passages;
+    }
+
+    inline std::vector<char> mazePassages(const int64_t &rows,
+                                          const int64_t &columns,
+                                          const MazeAlgorithm &algorithm,
+                                          const double &loops) {
+        auto passages = algorithm == MazeAlgorithm::kWilson ?
+                        wilsonMaze(rows, columns) : kruskalMaze(rows, columns);
+        if (loops <= 0)
+            return passages;
+
+        // every wall still there opened with probability `loops`
+        std::bernoulli_distribution distribution(loops);
+        auto &generator = Generator::getGenerator();
+        for (int64_t room = 0; room < rows * columns; ++room) {
+            if (room % columns + 1 < columns && !(passages[room] & kRightOpen) &&
+                    distribution(generator))
+                passages[room] |= kRightOpen;
+            if (room + columns < rows * columns &&
+                    !(passages[room] & kDownOpen) && distribution(generator))
+                passages[room] |= kDownOpen;
+        }
+        return passages;
+    }
+
+    template<class Emit>
+    void mazeEdges(const int64_t &rows, const int64_t &columns,
+                   const MazeAlgorithm &algorithm, const double &loops,
+                   Emit emit) {
+        auto passages = mazePassages(rows, columns, algorithm, loops);
+        for (int64_t room = 0; room < rows * columns; ++room) {
+            if (passages[room] & kRightOpen)
+                emit(room, room + 1);
+            if (passages[room] & kDownOpen)
+                emit(room, room + columns);
+        }
+    }
+
+    // breadth first over the open cells from `from` in 4 directions, one
+    // distance at a time up to `maximum`; `visit(cell, distance)` returning
+    // false stops it
+    template<class Visit>
+    void gridSearch(const CharMatrix &grid, const int64_t &from,
+                    const int64_t &maximum, Visit visit) {
+        const int64_t rows = grid.rows(), columns = grid.columns();
+        const std::string &cells = grid.data();
+        std::vector<char> seen(rows * columns, 0);
+        // (cell, its column), so no division is needed to find the edges
+        std::vector< std::pair<int64_t, int64_t> > current, next;
+        current.push_back(std::make_pair(from, from % columns));
+        seen[from] = 1;
+
+        for (int64_t distance = 0; !current.empty(); ++distance) {
+            for (auto &cell : current)
+                if (!visit(cell.first, distance))
+                    return;
+            if (distance == maximum)
+                return;
+
+            next.clear();
+            auto reach = [&](const int64_t &cell, const int64_t &column) {
+                if (!seen[cell] && cells[cell] != '#') {
+                    seen[cell] = 1;
+                    next.push_back(std::make_pair(cell, column));
+                }
+            };
+            for (auto &cell : current) {
+                const int64_t &column = cell.second;
+                if (column > 0)
+                    reach(cell.first - 1, column - 1);
+                if (column + 1 < columns)
+                    reach(cell.first + 1, column + 1);
+                if (cell.first >= columns)
+                    reach(cell.first - columns, column);
+                if (cell.first + columns < rows * columns)
+                    reach(cell.first + columns, column);
+            }
+            current.swap(next);
+        }
+    }
+
+    // whether two open cells are joined in 4 directions, through a
+    // union-find over the runs of open cells of every row, which goes
+    // through the grid in order unlike a breadth first search
+    inline bool gridJoined(const CharMatrix &grid, const int64_t &from,
+                           const int64_t &to) {
+        struct Run {
+            int64_t start, end, id;
+        };
+        const int64_t rows = grid.rows(), columns = grid.columns();
+        const std::string &cells = grid.data();
+
+        std::vector<int64_t> parent;
+        auto find = [&parent](int64_t run) {
+            while (parent[run] != run) {
+                parent[run] = parent[parent[run]];
+                run = parent[run];
+            }
+            return run;
+        };
+
+        std::vector<Run> above, here;
+        int64_t fromRun = -1, toRun = -1;
+        for (int64_t row = 0; row < rows; ++row) {
+            here.clear();
+            const int64_t first = row * columns;
+            size_t overlap = 0;
+            for (int64_t column = 0; column < columns; ) {
+                if (cells[first + column] == '#') {
+                    ++column;
+                    continue;
+                }
+                Run run = {column, column, int64_t(parent.size())};
+                while (run.end < columns && cells[first + run.end] != '#')
+                    ++run.end;
+                column = run.end;
+                parent.push_back(run.id);
+                if (from >= first + run.start && from < first + run.end)
+                    fromRun = run.id;
+                if (to >= first + run.start && to < first + run.end)
+                    toRun = run.id;
+
+                // the runs of the row above that touch this one
+                while (overlap < above.size() &&
+                       above[overlap].end <= run.start)
+                    ++overlap;
+                for (size_t i = overlap;
+                     i < above.size() && above[i].start < run.end; ++i)
+                    parent[find(above[i].id)] = run.id;
+                here.push_back(run);
+            }
+            above.swap(here);
+        }
+        return fromRun >= 0 && toRun >= 0 && find(fromRun) == find(toRun);
+    }
+
+    inline void checkCell(const CharMatrix &grid,
+                          const std::pair<int64_t, int64_t> &cell) {
+        if (cell.first < 0 || cell.first >= int64_t(grid.rows()) ||
+                cell.second < 0 || cell.second >= int64_t(grid.columns()))
+            throw Exception("Cells must be inside the grid");
+    }
+}  // namespace help
+
+// every cell joined to the ones next to it, `diagonals` for 8 of them
+// instead of 4
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> gridGraph(const size_t &rows, const size_t &columns,
+                                    Boolean::Object diagonals = Boolean::False) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (rows <= 0 || columns <= 0)
+        throw Exception("Grids must have strictly positive sizes");
+#endif
+    Graph<NodeData, EdgeData> graph(rows * columns);
+    help::gridEdges(rows, columns, static_cast<bool>(diagonals),
+                    [](const int64_t &) { return true; },
+                    [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+    return graph;
+}
+
+template<class Sink>
+void gridGraph(const size_t &rows, const size_t &columns,
+               Boolean::Object diagonals, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (rows <= 0 || columns <= 0)
+        throw Exception("Grids must have strictly positive sizes");
+#endif
+    help::gridEdges(rows, columns, static_cast<bool>(diagonals),
+                    [](const int64_t &) { return true; },
+                    [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
+
+// only the open cells are joined, the walls stay as nodes without edges
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> gridGraph(const CharMatrix &grid,
+                                    Boolean::Object diagonals = Boolean::False) {
+    Graph<NodeData, EdgeData> graph(grid.rows() * grid.columns());
+    help::gridEdges(grid.rows(), grid.columns(), static_cast<bool>(diagonals),
+                    [&grid](const int64_t &cell) {
+        return grid.data()[cell] != '#';
+    }, [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+    return graph;
+}
+
+template<class Sink>
+void gridGraph(const CharMatrix &grid, Boolean::Object diagonals, Sink sink) {
+    help::gridEdges(grid.rows(), grid.columns(), static_cast<bool>(diagonals),
+                    [&grid](const int64_t &cell) {
+        return grid.data()[cell] != '#';
+    }, [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
+
+// a maze of rows x columns rooms, a spanning tree of the grid with every
+// other wall also opened with probability `loops`
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> maze(
+        const size_t &rows, const size_t &columns,
+        const MazeAlgorithm &algorithm = MazeAlgorithm::kKruskal,
+        const double &loops = 0) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (rows <= 0 || columns <= 0 || rows * columns >= (size_t(1) << 31))
+        throw Exception("Mazes must have between 1 and 2^31 - 1 rooms");
+    if (loops < 0 || loops > 1)
+        throw Exception("Loops must have a probability between 0 and 1");
+#endif
+    Graph<NodeData, EdgeData> graph(rows * columns);
+    help::mazeEdges(rows, columns, algorithm, loops,
+                    [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+    return graph;
+}
+
+template<class Sink>
+void maze(const size_t &rows, const size_t &columns,
+          const MazeAlgorithm &algorithm, const double &loops, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (rows <= 0 || columns <= 0 || rows * columns >= (size_t(1) << 31))
+        throw Exception("Mazes must have between 1 and 2^31 - 1 rooms");
+    if (loops < 0 || loops > 1)
+        throw Exception("Loops must have a probability between 0 and 1");
+#endif
+    help::mazeEdges(rows, columns, algorithm, loops,
+                    [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
+
+// the same maze as characters, 2 * rows + 1 by 2 * columns + 1
+CharMatrix mazeMatrix(const size_t &rows, const size_t &columns,
+                      const MazeAlgorithm &algorithm = MazeAlgorithm::kKruskal,
+                      const double &loops = 0) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (rows <= 0 || columns <= 0 || rows * columns >= (size_t(1) << 31))
+        throw Exception("Mazes must have between 1 and 2^31 - 1 rooms");
+    if (loops < 0 || loops > 1)
+        throw Exception("Loops must have a probability between 0 and 1");
+#endif
+    auto passages = help::mazePassages(rows, columns, algorithm, loops);
+    CharMatrix matrix(2 * rows + 1, 2 * columns + 1, '#');
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < columns; ++j) {
+            const char room = passages[i * columns + j];
+            matrix(2 * i + 1, 2 * j + 1) = '.';
+            if (room & help::kRightOpen)
+                matrix(2 * i + 1, 2 * j + 2) = '.';
+            if (room & help::kDownOpen)
+                matrix(2 * i + 2, 2 * j + 1) = '.';
+        }
+    return matrix;
+}
+
+// every cell an obstacle with probability `density`, but `from` and `to`
+// (as (row, column)) open and joined through open cells in 4 directions: if
+// the obstacles cut them apart a random staircase from one to the other is
+// cleared
+CharMatrix obstacleGrid(const size_t &rows, const size_t &columns,
+                        const double &density,
+                        const std::pair<int64_t, int64_t> &from,
+                        const std::pair<int64_t, int64_t> &to) {
+    CharMatrix grid(rows, columns, '.');
+#ifdef INPUT_GENERATOR_DEBUG
+    if (rows <= 0 || columns <= 0)
+        throw Exception("Grids must have strictly positive sizes");
+    if (density < 0 || density > 1)
+        throw Exception("Obstacles must have a density between 0 and 1");
+    help::checkCell(grid, from);
+    help::checkCell(grid, to);
+#endif
+    const int64_t cells = rows * columns;
+    if (density >= 1) {
+        grid = CharMatrix(rows, columns, '#');
+    } else if (density > 0) {
+        // the gap to the next obstacle is geometric, as in
+        // binomialGraphEdges
+        const double logMiss = std::log1p(-density);
+        std::uniform_real_distribution<double> distribution(0, 1);
+        int64_t cell = -1;
+        while (true) {
+            double skip = std::floor(
+                std::log1p(-distribution(Generator::getGenerator())) /
+                logMiss);
+            if (skip >= static_cast<double>(cells - cell - 1))
+                break;
+            cell += 1 + static_cast<int64_t>(skip);
+            grid(cell / columns, cell % columns) = '#';
+        }
+    }
+    grid(from.first, from.second) = grid(to.first, to.second) = '.';
+
+    const int64_t start = from.first * columns + from.second,
+                  finish = to.first * columns + to.second;
+    if (help::gridJoined(grid, start, finish))
+        return grid;
+
+    int64_t row = from.first, column = from.second;
+    int64_t down = to.first - row, right = to.second - column;
+    while (down != 0 || right != 0) {
+        if (randomInt<int64_t>(1, std::llabs(down) + std::llabs(right)) <=
+                std::llabs(down)) {
+            const int64_t move = down > 0 ? 1 : -1;
+            row += move;
+            down -= move;
+        } else {
+            const int64_t move = right > 0 ? 1 : -1;
+            column += move;
+            right -= move;
+        }
+        grid(row, column) = '.';
+    }
+    return grid;
+}
+
+// a random open cell whose shortest path from `from` through open cells in
+// 4 directions has exactly `length` steps, for the other end of a path
+// of a given length in a maze or an obstacle grid
+std::pair<int64_t, int64_t> cellAtDistance(
+        const CharMatrix &grid, const std::pair<int64_t, int64_t> &from,
+        const int64_t &length) {
+#ifdef INPUT_GENERATOR_DEBUG
+    help::checkCell(grid, from);
+    if (grid(from.first, from.second) == '#')
+        throw Exception("Paths must start in an open cell");
+#endif
+    const int64_t columns = grid.columns();
+    std::vector<int64_t> candidates;
+    help::gridSearch(grid, from.first * columns + from.second, length,
+                     [&](const int64_t &cell, const int64_t &distance) {
+        if (distance == length)
+            candidates.push_back(cell);
+        return true;
+    });
+    if (candidates.empty())
+        throw Exception("No open cell is that far from the start");
+
+    const int64_t cell = randomElement(candidates);
+    return std::make_pair(cell / columns, cell % columns);
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_GRID_HPP_
@@ -0,0 +1,184 @@
+#ifndef INPUT_GENERATOR_GZIP_WRITER_HPP_
+#define INPUT_GENERATOR_GZIP_WRITER_HPP_
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "exception.hpp"
+#include "thread_pool.hpp"
+#include "writer.hpp"
+
+namespace inputGenerator {
+
+/**
+ * A Writer that gzips what it's given on the way out (link with -lz)
+ * The output is cut in blocks and every block becomes a gzip member of its
+ * own, so blocks are compressed on a thread pool and the file is still one
+ * that gzip, zcat and zlib read as a whole
+ * flush() only closes the current block, blocks go out a round at a time
+ * and the last ones when the writer dies
+ */
+class GzipWriter : public Writer {
+  public:
+    static const size_t kDefaultBlock = 1 << 20;
+
+    // on a pool of its own, one thread per core
+    explicit GzipWriter(const std::string &path,
+                        const int &level = Z_DEFAULT_COMPRESSION,
+                        const size_t &blockSize = kDefaultBlock);
+
+    GzipWriter(const std::string &path, ThreadPool &pool,
+               const int &level = Z_DEFAULT_COMPRESSION,
+               const size_t &blockSize = kDefaultBlock);
+
+    // the descriptor is not closed (1 is the standard output)
+    GzipWriter(const int &fd, ThreadPool &pool,
+               const int &level = Z_DEFAULT_COMPRESSION,
+               const size_t &blockSize = kDefaultBlock);
+
+    ~GzipWriter();
+
+    // closes the current block and starts the next one
+    void flush();
+
+    void writeChunks(const struct iovec *chunks, const size_t &count);
+
+  private:
+    void start(const size_t &blockSize);
+
+    // compresses the closed blocks and writes them
+    void compress();
+
+    std::unique_ptr<ThreadPool> ownPool_;
+    ThreadPool *pool_;
+    int level_;
+
+    std::vector< std::vector<char> > blocks_, compressed_;
+    std::vector<size_t> sizes_;
+    size_t closed_;
+};
+
+const size_t GzipWriter::kDefaultBlock;
+
+GzipWriter::GzipWriter(const std::string &path, const int &level,
+                       const size_t &blockSize):
+        Writer(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644), true),
+        ownPool_(new ThreadPool()),
+        pool_(ownPool_.get()),
+        level_(level) {
+    if (fd_ < 0)
+        throw Exception("GzipWriter could not open the output file");
+    start(blockSize);
+}
+
+GzipWriter::GzipWriter(const std::string &path, ThreadPool &pool,
+                       const int &level, const size_t &blockSize):
+        Writer(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644), true),
+        pool_(&pool),
+        level_(level) {
+    if (fd_ < 0)
+        throw Exception("GzipWriter could not open the output file");
+    start(blockSize);
+}
+
+GzipWriter::GzipWriter(const int &fd, ThreadPool &pool, const int &level,
+                       const size_t &blockSize):
+        Writer(fd, false),
+        pool_(&pool),
+        level_(level) {
+    start(blockSize);
+}
+
+void GzipWriter::start(const size_t &blockSize) {
+    // a round is two blocks a thread, compressed all at once when it fills
+    blocks_.resize(2 * pool_->size());
+    for (auto &block : blocks_)
+        block.resize(std::max<size_t>(blockSize, 2 * kMaximumNumber + 2));
+    compressed_.resize(blocks_.size());
+    sizes_.assign(blocks_.size(), 0);
+    closed_ = 0;
+
+    begin_ = position_ = blocks_[0].data();
+    end_ = begin_ + blocks_[0].size();
+}
+
+GzipWriter::~GzipWriter() {
+    try {
+        flush();
+        // an empty file is not gzip, nothing becomes an empty member
+        if (written() == 0)
+            sizes_[closed_++] = 0;
+        compress();
+    } catch (...) {
+    }
+    // there's nothing left for Writer to flush
+    begin_ = position_ = end_ = nullptr;
+}
+
+void GzipWriter::flush() {
+    size_t size = position_ - begin_;
+    if (size > 0) {
+        sizes_[closed_++] = size;
+        flushed_ += size;
+        if (closed_ == blocks_.size())
+            compress();
+    }
+
+    begin_ = position_ = blocks_[closed_].data();
+    end_ = begin_ + blocks_[closed_].size();
+}
+
+void GzipWriter::compress() {
+    if (closed_ == 0)
+        return;
+
+    pool_->run(closed_, [this](size_t block) {
+        z_stream stream;
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        // 16 more bits of window ask for a gzip header and trailer
+        if (deflateInit2(&stream, level_, Z_DEFLATED, 15 + 16, 8,
+                         Z_DEFAULT_STRATEGY) != Z_OK)
+            throw Exception("GzipWriter could not start zlib");
+
+        std::vector<char> &output = compressed_[block];
+        output.resize(deflateBound(&stream, sizes_[block]));
+
+        stream.next_in = reinterpret_cast<Bytef*>(blocks_[block].data());
+        stream.avail_in = static_cast<uInt>(sizes_[block]);
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+
+        int result = deflate(&stream, Z_FINISH);
+        output.resize(output.size() - stream.avail_out);
+        deflateEnd(&stream);
+        if (result != Z_STREAM_END)
+            throw Exception("GzipWriter could not compress a block");
+    });
+
+    std::vector<struct iovec> chunks(closed_);
+    for (size_t block = 0; block < closed_; ++block) {
+        chunks[block].iov_base = compressed_[block].data();
+        chunks[block].iov_len = compressed_[block].size();
+    }
+    drainChunks(chunks.data(), chunks.size());
+    closed_ = 0;
+}
+
+void GzipWriter::writeChunks(const struct iovec *chunks, const size_t &count) {
+    for (size_t i = 0; i < count; ++i)
+        write(static_cast<const char*>(chunks[i].iov_base), chunks[i].iov_len);
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_GZIP_WRITER_HPP_
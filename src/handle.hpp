@@ -0,0 +1,222 @@
+#ifndef INPUT_GENERATOR_HANDLE_HPP_
+#define INPUT_GENERATOR_HANDLE_HPP_
+
+#include <cstddef>
+#include <utility>
+
+#ifndef INPUT_GENERATOR_SINGLE_THREADED
+#include <atomic>
+#endif
+
+namespace inputGenerator {
+
+/**
+ * Intrusive reference counting for nodes, edge data and arenas
+ * Define INPUT_GENERATOR_SINGLE_THREADED and the counters become plain
+ * integers, then copying a node or an edge is just an increment
+ * Without it they're atomic so handles to the same object can be
+ * copied from several threads (graphs built on different threads never share
+ * objects so they are fine either way)
+ */
+#ifdef INPUT_GENERATOR_SINGLE_THREADED
+typedef unsigned _ReferenceCount;
+
+inline bool _retainIfAlive(_ReferenceCount &count) {
+    if (count == 0)
+        return false;
+    ++count;
+    return true;
+}
+#else
+typedef std::atomic<unsigned> _ReferenceCount;
+
+inline bool _retainIfAlive(_ReferenceCount &count) {
+    unsigned value = count.load();
+    do {
+        if (value == 0)
+            return false;
+    } while (!count.compare_exchange_weak(value, value + 1));
+    return true;
+}
+#endif
+
+template<class T>
+class _Handle;
+
+template<class T>
+class _WeakHandle;
+
+/**
+ * Objects behind handles derive from this
+ * They can hide _dispose(), called when the last strong handle goes away
+ * (weak handles may still look at the object), and _destroy(), called when
+ * nobody sees the object anymore
+ */
+class _Counted {
+  public:
+    void _dispose() {
+    }
+
+    template<class T>
+    static void _destroy(T *object) {
+        delete object;
+    }
+
+  protected:
+    // all strong handles together hold one weak reference
+    _Counted(): _strong(0), _weak(1) {
+    }
+
+    // the counts belong to the object, they are never copied
+    _Counted(const _Counted&): _strong(0), _weak(1) {
+    }
+
+    _Counted& operator=(const _Counted&) {
+        return *this;
+    }
+
+  private:
+    template<class T>
+    friend class _Handle;
+
+    template<class T>
+    friend class _WeakHandle;
+
+    _ReferenceCount _strong, _weak;
+};
+
+template<class T>
+class _Handle {
+  public:
+    _Handle(): pointer_(nullptr) {
+    }
+
+    explicit _Handle(T *pointer): pointer_(pointer) {
+        if (pointer_)
+            ++pointer_->_strong;
+    }
+
+    _Handle(const _Handle &that): pointer_(that.pointer_) {
+        if (pointer_)
+            ++pointer_->_strong;
+    }
+
+    _Handle(_Handle &&that): pointer_(that.pointer_) {
+        that.pointer_ = nullptr;
+    }
+
+    ~_Handle() {
+        release();
+    }
+
+    _Handle& operator=(_Handle that) {
+        std::swap(pointer_, that.pointer_);
+        return *this;
+    }
+
+    void reset() {
+        release();
+        pointer_ = nullptr;
+    }
+
+    T* get() const {
+        return pointer_;
+    }
+
+    T& operator*() const {
+        return *pointer_;
+    }
+
+    T* operator->() const {
+        return pointer_;
+    }
+
+    explicit operator bool() const {
+        return pointer_ != nullptr;
+    }
+
+    unsigned useCount() const {
+        return pointer_ ? static_cast<unsigned>(pointer_->_strong) : 0;
+    }
+
+    bool operator==(const _Handle &that) const {
+        return pointer_ == that.pointer_;
+    }
+
+    bool operator!=(const _Handle &that) const {
+        return pointer_ != that.pointer_;
+    }
+
+  private:
+    friend class _WeakHandle<T>;
+
+    // only for lock, the count was already taken
+    _Handle(T *pointer, bool): pointer_(pointer) {
+    }
+
+    void release() {
+        if (!pointer_)
+            return;
+
+        if (--pointer_->_strong == 0) {
+            pointer_->_dispose();
+            if (--pointer_->_weak == 0)
+                T::_destroy(pointer_);
+        }
+    }
+
+    T *pointer_;
+};
+
+template<class T>
+class _WeakHandle {
+  public:
+    _WeakHandle(): pointer_(nullptr) {
+    }
+
+    explicit _WeakHandle(const _Handle<T> &that): pointer_(that.get()) {
+        if (pointer_)
+            ++pointer_->_weak;
+    }
+
+    _WeakHandle(const _WeakHandle &that): pointer_(that.pointer_) {
+        if (pointer_)
+            ++pointer_->_weak;
+    }
+
+    _WeakHandle(_WeakHandle &&that): pointer_(that.pointer_) {
+        that.pointer_ = nullptr;
+    }
+
+    ~_WeakHandle() {
+        release();
+    }
+
+    _WeakHandle& operator=(_WeakHandle that) {
+        std::swap(pointer_, that.pointer_);
+        return *this;
+    }
+
+    _Handle<T> lock() const {
+        if (pointer_ && _retainIfAlive(pointer_->_strong))
+            return _Handle<T>(pointer_, true);
+        return _Handle<T>();
+    }
+
+    // the object may be dead, use it only as a key
+    T* get() const {
+        return pointer_;
+    }
+
+  private:
+    void release() {
+        if (pointer_ && --pointer_->_weak == 0)
+            T::_destroy(pointer_);
+    }
+
+    T *pointer_;
+};
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_HANDLE_HPP_
@@ -0,0 +1,196 @@
+#ifndef INPUT_GENERATOR_MAPPED_WRITER_HPP_
+#define INPUT_GENERATOR_MAPPED_WRITER_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "exception.hpp"
+#include "boolean.hpp"
+#include "graph.hpp"
+#include "writer.hpp"
+
+namespace inputGenerator {
+
+/**
+ * A Writer that formats straight into the output file through mmap, there's
+ * no buffer of ours and no write(2) copy
+ * The file is sized up front (see edgeListSize and vectorSize for the exact
+ * numbers) and mapped one window at a time, so memory stays at a window no
+ * matter how big the file gets
+ * A size that's too small only costs growing the file, one that's too big
+ * is cut to what was written when the writer dies
+ */
+class MappedWriter : public Writer {
+  public:
+    static const size_t kDefaultWindow = 1 << 26;
+
+    MappedWriter(const std::string &path, const uint64_t &size,
+                 const size_t &window = kDefaultWindow);
+
+    ~MappedWriter();
+
+    // maps the window that starts where the writer is
+    void flush();
+
+    // copied into the mapping like everything else
+    void writeChunks(const struct iovec *chunks, const size_t &count);
+
+  private:
+    void unmap();
+
+    char *map_;
+    size_t mapSize_;
+    uint64_t capacity_;
+    size_t window_;
+};
+
+const size_t MappedWriter::kDefaultWindow;
+
+MappedWriter::MappedWriter(const std::string &path, const uint64_t &size,
+                           const size_t &window):
+        Writer(open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644), true),
+        map_(nullptr),
+        mapSize_(0),
+        capacity_(size) {
+    if (fd_ < 0)
+        throw Exception("MappedWriter could not open the output file");
+
+    // whole pages, and enough of them that a number always fits
+    const size_t page = sysconf(_SC_PAGESIZE);
+    window_ = std::max<size_t>((window + page - 1) / page * page, 2 * page);
+
+    if (ftruncate(fd_, capacity_) < 0)
+        throw Exception("MappedWriter could not size the output file");
+    flush();
+}
+
+MappedWriter::~MappedWriter() {
+    uint64_t size = written();
+    unmap();
+    if (ftruncate(fd_, size) < 0) {
+        // nothing to do about it here, the file keeps its tail of zeroes
+    }
+}
+
+void MappedWriter::unmap() {
+    if (map_ != nullptr)
+        munmap(map_, mapSize_);
+    map_ = nullptr;
+    mapSize_ = 0;
+    begin_ = position_ = end_ = nullptr;
+}
+
+void MappedWriter::flush() {
+    uint64_t offset = written();
+    unmap();
+
+    // the estimate was short, the file grows by a window
+    if (capacity_ - offset < static_cast<uint64_t>(2 * kMaximumNumber + 2)) {
+        capacity_ = offset + window_;
+        if (ftruncate(fd_, capacity_) < 0)
+            throw Exception("MappedWriter could not grow the output file");
+    }
+
+    // mappings start on a page
+    const uint64_t page = sysconf(_SC_PAGESIZE);
+    uint64_t start = offset / page * page;
+    mapSize_ = std::min<uint64_t>(window_, capacity_ - start);
+
+    void *map = mmap(nullptr, mapSize_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd_, start);
+    if (map == MAP_FAILED) {
+        mapSize_ = 0;
+        throw Exception("MappedWriter could not map the output file");
+    }
+    map_ = static_cast<char*>(map);
+    madvise(map_, mapSize_, MADV_SEQUENTIAL);
+
+    begin_ = position_ = map_ + (offset - start);
+    end_ = map_ + mapSize_;
+    flushed_ = offset;
+}
+
+void MappedWriter::writeChunks(const struct iovec *chunks,
+                               const size_t &count) {
+    for (size_t i = 0; i < count; ++i)
+        write(static_cast<const char*>(chunks[i].iov_base), chunks[i].iov_len);
+}
+
+/**
+ * Exact sizes of what the serializers in writer.hpp print
+ */
+
+namespace help {
+    // also counts the edges, so the header needs no second pass
+    template<class NodeData, class EdgeData>
+    uint64_t edgeListSize(const Graph<NodeData, EdgeData> &graph,
+                          Boolean::Object header, uint64_t &edges) {
+        uint64_t size = 0;
+        edges = 0;
+        for (auto &edge : graph.edgeRange()) {
+            size += formattedSize(graph.label(edge.fromIndex())) +
+                    formattedSize(graph.label(edge.toIndex())) + 2;
+            ++edges;
+        }
+
+        if (header)
+            size += formattedSize(graph.size()) + formattedSize(edges) + 2;
+        return size;
+    }
+}  // namespace help
+
+template<class NodeData, class EdgeData>
+uint64_t edgeListSize(const Graph<NodeData, EdgeData> &graph,
+                      Boolean::Object header = Boolean::True) {
+    uint64_t edges;
+    return help::edgeListSize(graph, header, edges);
+}
+
+// for containers of integers, a result of randomSample for instance
+template<class Container>
+uint64_t vectorSize(const Container &data) {
+    static_assert(std::is_integral<typename std::decay<
+                      decltype(*std::begin(data))>::type>::value,
+                  "vectorSize expects a container of integers");
+
+    uint64_t size = 0, elements = 0;
+    for (auto &element : data) {
+        size += help::formattedSize(element);
+        ++elements;
+    }
+    // the separators and the new line
+    return size + std::max<uint64_t>(elements, 1);
+}
+
+/**
+ * Sizes the file, maps it and writes the output in one go
+ */
+
+template<class NodeData, class EdgeData>
+void mapEdgeList(const std::string &path,
+                 const Graph<NodeData, EdgeData> &graph,
+                 Boolean::Object header = Boolean::True) {
+    uint64_t edges;
+    MappedWriter writer(path, help::edgeListSize(graph, header, edges));
+    if (header)
+        writer << graph.size() << ' ' << edges << '\n';
+    writeEdgeList(writer, graph, Boolean::False);
+}
+
+template<class Container>
+void mapVector(const std::string &path,
+               const Container &data,
+               const char &separator = ' ') {
+    MappedWriter writer(path, vectorSize(data));
+    writeVector(writer, data, separator);
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_MAPPED_WRITER_HPP_
@@ -2,11 +2,19 @@
 #define INPUT_GENERATOR_NODE_HPP_
 
 #include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <map>
-#include <memory>
+#include <utility>
 #include <vector>
 
+#include "arena.hpp"
 #include "exception.hpp"
+#include "handle.hpp"
+#include "range.hpp"
 
 namespace inputGenerator {
 
@@ -27,20 +35,29 @@ class NodeWrapperBase;
 template<class NodeData, class EdgeData>
 class Graph;
 
+template<class NodeData, class EdgeData>
+class _AdjacencyIterator;
+
 /**
  * Memory used is 16 * 2 ( from unordered multimaps) + 8 (the key and index) + (the data which by default is 4)
  */
 template<class NodeData, class EdgeData>
-class _NodeBase {
+class _Node;
+
+template<class NodeData, class EdgeData>
+class _NodeBase : public _Counted {
   public:
     typedef _NodeBase<NodeData, EdgeData> NodeType;
     typedef _Edge<NodeData, EdgeData> EdgeType;
+    typedef std::vector<EdgeType, ArenaAllocator<EdgeType>> SortedAdjacency;
 
-    explicit _NodeBase(const int &_index = 0);
+    explicit _NodeBase(const int64_t &_index = 0, Arena *arena = nullptr);
+
+    ~_NodeBase();
 
     EdgeType addEdge(NodeType&);
 
-    EdgeType addEdge(NodeType&, const unsigned &key);
+    EdgeType addEdge(NodeType&, const uint64_t &key);
 
     EdgeType addEdge(const EdgeType&);
 
@@ -62,32 +79,149 @@ class _NodeBase {
 
     void clear();
 
+    // from now on the edges are also kept sorted by the index of the other
+    // end (then by when they were added), see sorted()
+    void sortAdjacency();
+
+    // sorts them again, needed when indexes of the neighbours change
+    void resortAdjacency();
+
+    // null unless sortAdjacency() was called
+    const SortedAdjacency* sorted() const {
+        return _sorted;
+    }
+
+    // where the adjacency lives, null for nodes made outside of a graph
+    Arena* arena() const {
+        return _arena.get();
+    }
+
+    // the last handle is gone, let go of the neighbours
+    void _dispose() {
+        clear();
+    }
+
+    static void _destroy(_Node<NodeData, EdgeData> *node) {
+        // the node's memory is in the arena, keep it around until we're done
+        _Handle<Arena> arena(node->_arena);
+        arenaDelete(arena.get(), node);
+    }
+
     // the index of the node
-    int index;
+    int64_t index;
 
   private:
     friend class _Edge<NodeData, EdgeData>;
     friend class NodeWrapper<NodeData, EdgeData>;
     friend class NodeWrapperBase<NodeData, EdgeData>;
+    friend class Graph<NodeData, EdgeData>;
+    friend class _AdjacencyIterator<NodeData, EdgeData>;
+
+    _NodeBase(const _NodeBase&);
+
+    void operator=(const _NodeBase&);
+
+    // puts a new edge in all the places we keep it
+    void store(const EdgeType&);
+
+    // marks all the copies of the edge we keep as being an edge or only
+    // an arc
+    void setEdge(const uint64_t &key, const bool &isEdge);
+
+    static bool sortedBefore(const EdgeType &first, const EdgeType &second) {
+        if (first.toIndex() != second.toIndex())
+            return first.toIndex() < second.toIndex();
+        return first.getKey() < second.getKey();
+    }
+
+    // where `edge` is in _sorted, a linear search only if the indexes
+    // changed without a resort
+    typename SortedAdjacency::iterator findSorted(const EdgeType &edge);
+
+    _Handle<Arena> _arena;
 
     // damn that's a lot, lot of memory, we're lucky we don't copy the data
     // well it's only 4 bytes anyway so that's not much of an improvement
     // now for a graph of N nodes and E edges we have at least
     // N * 44 + 2 * E * 20 bytes occupied
+    typedef ArenaAllocator<std::pair<const NodeType* const, EdgeType>>
+            NeighbourAllocator;
+    typedef ArenaAllocator<std::pair<const uint64_t, EdgeType>> EdgeAllocator;
 #ifdef INPUT_GENERATOR_NODE_MAP
-    std::multimap<const NodeType*, EdgeType> _neighbours;
-    std::map<unsigned, EdgeType> _edges;
+    std::multimap<const NodeType*, EdgeType, std::less<const NodeType*>,
+                  NeighbourAllocator> _neighbours;
+    typedef std::map<uint64_t, EdgeType, std::less<uint64_t>,
+                     EdgeAllocator> EdgeMap;
 #else
-    std::unordered_multimap<const NodeType*, EdgeType> _neighbours;
-    std::unordered_map<unsigned, EdgeType> _edges;
+    std::unordered_multimap<const NodeType*, EdgeType,
+                            std::hash<const NodeType*>,
+                            std::equal_to<const NodeType*>,
+                            NeighbourAllocator> _neighbours;
+    typedef std::unordered_map<uint64_t, EdgeType, std::hash<uint64_t>,
+                               std::equal_to<uint64_t>,
+                               EdgeAllocator> EdgeMap;
 #endif
+    EdgeMap _edges;
+
+    SortedAdjacency *_sorted;
 };
 
 template<class NodeData, class EdgeData>
-_NodeBase<NodeData, EdgeData>::_NodeBase(const int &_index) {
+_NodeBase<NodeData, EdgeData>::_NodeBase(const int64_t &_index,
+                                         Arena *arena):
+        _arena(arena),
+        _neighbours(NeighbourAllocator(arena)),
+        _edges(EdgeAllocator(arena)),
+        _sorted(nullptr) {
     index = _index;
 }
 
+template<class NodeData, class EdgeData>
+_NodeBase<NodeData, EdgeData>::~_NodeBase() {
+    if (_sorted)
+        arenaDelete(_arena.get(), _sorted);
+}
+
+template<class NodeData, class EdgeData>
+void _NodeBase<NodeData, EdgeData>::store(const EdgeType &edge) {
+    _neighbours.insert({edge._to.get(), edge});
+    _edges.insert({edge.getKey(), edge});
+
+    if (_sorted)
+        _sorted->insert(std::upper_bound(_sorted->begin(), _sorted->end(),
+                                         edge, sortedBefore),
+                        edge);
+}
+
+template<class NodeData, class EdgeData>
+typename _NodeBase<NodeData, EdgeData>::SortedAdjacency::iterator
+_NodeBase<NodeData, EdgeData>::findSorted(const EdgeType &edge) {
+    auto it = std::lower_bound(_sorted->begin(), _sorted->end(), edge,
+                               sortedBefore);
+    if (it != _sorted->end() && *it == edge)
+        return it;
+    return std::find(_sorted->begin(), _sorted->end(), edge);
+}
+
+template<class NodeData, class EdgeData>
+void _NodeBase<NodeData, EdgeData>::sortAdjacency() {
+    if (_sorted)
+        return;
+
+    _sorted = arenaNew<SortedAdjacency>(_arena.get(),
+            ArenaAllocator<EdgeType>(_arena.get()));
+    _sorted->reserve(_edges.size());
+    for (auto &edge : _edges)
+        _sorted->push_back(edge.second);
+    std::sort(_sorted->begin(), _sorted->end(), sortedBefore);
+}
+
+template<class NodeData, class EdgeData>
+void _NodeBase<NodeData, EdgeData>::resortAdjacency() {
+    if (_sorted)
+        std::sort(_sorted->begin(), _sorted->end(), sortedBefore);
+}
+
 template<class NodeData, class EdgeData>
 bool _NodeBase<NodeData, EdgeData>::hasEdge(const EdgeType& edge) const {
     return _edges.count(edge.getKey()) > 0;
@@ -99,11 +233,17 @@ bool _NodeBase<NodeData, EdgeData>::eraseEdge(const EdgeType& edge) {
     if (hasEdge(edge) == false)
         return false;
     auto realEdge = _edges.find(edge.getKey());
-    auto where = _neighbours.equal_range(
-            realEdge->second.to().internalNode.get());
+    NodeType *otherNode = realEdge->second._to.get();
+    auto where = _neighbours.equal_range(otherNode);
 
     for (auto it = where.first; it != where.second; ++it)
         if (it -> second == realEdge -> second) {
+            // whatever is left at the other end is only an arc now
+            if (realEdge->second.isEdge() && otherNode != this)
+                otherNode->setEdge(edge.getKey(), false);
+
+            if (_sorted)
+                _sorted->erase(findSorted(realEdge->second));
             _neighbours.erase(it);
             _edges.erase(realEdge);
             return true;
@@ -112,6 +252,25 @@ bool _NodeBase<NodeData, EdgeData>::eraseEdge(const EdgeType& edge) {
     throw Exception("Edge was in normal list but not in neighbour list");
 }
 
+template<class NodeData, class EdgeData>
+void _NodeBase<NodeData, EdgeData>::setEdge(const uint64_t &key,
+                                            const bool &isEdge) {
+    auto edge = _edges.find(key);
+    if (edge == _edges.end())
+        return;
+
+    edge->second.setEdge(isEdge);
+    if (_sorted)
+        findSorted(edge->second)->setEdge(isEdge);
+
+    auto where = _neighbours.equal_range(edge->second._to.get());
+    for (auto it = where.first; it != where.second; ++it)
+        if (it->second == edge->second) {
+            it->second.setEdge(isEdge);
+            return;
+        }
+}
+
 template<class NodeData, class EdgeData>
 std::vector<_Edge<NodeData, EdgeData>> _NodeBase<NodeData, EdgeData>::arcsTo(
         const NodeType& otherNode) const {
@@ -119,7 +278,7 @@ std::vector<_Edge<NodeData, EdgeData>> _NodeBase<NodeData, EdgeData>::arcsTo(
 
     auto range = _neighbours.equal_range(&otherNode);
     for (auto it = range.first; it != range.second; ++it)
-        if (!otherNode.hasEdge(it->second))
+        if (!it->second.isEdge())
             result.push_back(it->second);
     return result;
 }
@@ -131,7 +290,7 @@ std::vector<_Edge<NodeData, EdgeData>> _NodeBase<NodeData, EdgeData>::edgesTo(
 
     auto range = _neighbours.equal_range(&otherNode);
     for (auto it = range.first; it != range.second; ++it)
-        if (otherNode.hasEdge(it->second))
+        if (it->second.isEdge())
             result.push_back(it->second);
     return result;
 }
@@ -140,7 +299,7 @@ template<class NodeData, class EdgeData>
 bool _NodeBase<NodeData, EdgeData>::hasArc(const NodeType& otherNode) const {
     auto range = _neighbours.equal_range(&otherNode);
     for (auto it = range.first; it != range.second; ++it)
-        if (!otherNode.hasEdge(it->second))
+        if (!it->second.isEdge())
             return true;
     return false;
 }
@@ -149,7 +308,7 @@ template<class NodeData, class EdgeData>
 bool _NodeBase<NodeData, EdgeData>::hasEdge(const NodeType& otherNode) const {
     auto range = _neighbours.equal_range(&otherNode);
     for (auto it = range.first; it != range.second; ++it)
-        if (otherNode.hasEdge(it->second))
+        if (it->second.isEdge())
             return true;
     return false;
 }
@@ -159,7 +318,7 @@ std::vector<_Edge<NodeData, EdgeData>>
 _NodeBase<NodeData, EdgeData>::arcs() const {
     std::vector<EdgeType> result;
     for (auto &arc : _edges)
-        if (!arc.second._to.lock()->hasEdge(arc.second))
+        if (!arc.second.isEdge())
             result.push_back(arc.second);
     return result;
 }
@@ -169,7 +328,7 @@ std::vector<_Edge<NodeData, EdgeData>> _NodeBase<NodeData, EdgeData>
 ::edges() const {
     std::vector<EdgeType> result;
     for (auto &edge : _edges)
-        if (edge.second._to.lock()->hasEdge(edge.second))
+        if (edge.second.isEdge())
             result.push_back(edge.second);
     return result;
 }
@@ -178,6 +337,8 @@ template<class NodeData, class EdgeData>
 void _NodeBase<NodeData, EdgeData>::clear() {
     _neighbours.clear();
     _edges.clear();
+    if (_sorted)
+        _sorted->clear();
 }
 
 template<class NodeData, class EdgeData>
@@ -185,8 +346,8 @@ class _Node : public _NodeBase<NodeData, EdgeData> {
   public:
     typedef NodeData& DataType;
 
-    explicit _Node(const int &index = 0):
-            _NodeBase<NodeData, EdgeData>(index) {
+    explicit _Node(const int64_t &index = 0, Arena *arena = nullptr):
+            _NodeBase<NodeData, EdgeData>(index, arena) {
     }
 
     NodeData& data() {
@@ -201,8 +362,8 @@ class _Node<void, EdgeData> : public _NodeBase<void, EdgeData> {
   public:
     typedef int DataType;
 
-    explicit _Node(const int &index = 0):
-            _NodeBase<void, EdgeData>(index) {
+    explicit _Node(const int64_t &index = 0, Arena *arena = nullptr):
+            _NodeBase<void, EdgeData>(index, arena) {
     }
 
     int data() {
@@ -210,6 +371,101 @@ class _Node<void, EdgeData> : public _NodeBase<void, EdgeData> {
     }
 };
 
+/**
+ * Walks the edges going out of a node straight from its map, nothing is
+ * copied and no other node is looked at
+ * It can give all of them, only the edges or only the arcs
+ */
+template<class NodeData, class EdgeData>
+class _AdjacencyIterator {
+  public:
+    typedef _Edge<NodeData, EdgeData> EdgeType;
+
+    typedef std::ptrdiff_t difference_type;
+    typedef EdgeType value_type;
+    typedef const EdgeType* pointer;
+    typedef const EdgeType& reference;
+    typedef std::forward_iterator_tag iterator_category;
+
+    enum Kind {
+        kAll,
+        kEdges,
+        kArcs
+    };
+
+    _AdjacencyIterator(): kind_(kAll) {
+    }
+
+    reference operator*() const {
+        return position_->second;
+    }
+
+    pointer operator->() const {
+        return &position_->second;
+    }
+
+    _AdjacencyIterator& operator++() {
+        ++position_;
+        skip();
+        return *this;
+    }
+
+    _AdjacencyIterator operator++(int) {
+        _AdjacencyIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    bool operator==(const _AdjacencyIterator &that) const {
+        return position_ == that.position_;
+    }
+
+    bool operator!=(const _AdjacencyIterator &that) const {
+        return position_ != that.position_;
+    }
+
+  private:
+    friend class NodeWrapperBase<NodeData, EdgeData>;
+    friend class Graph<NodeData, EdgeData>;
+
+    typedef typename _NodeBase<NodeData, EdgeData>::EdgeMap::const_iterator
+            MapIterator;
+
+    _AdjacencyIterator(const MapIterator &position, const MapIterator &end,
+                       const Kind &kind):
+            position_(position),
+            end_(end),
+            kind_(kind) {
+        skip();
+    }
+
+    static _AdjacencyIterator begin(const _NodeBase<NodeData, EdgeData> &node,
+                                    const Kind &kind) {
+        return _AdjacencyIterator(node._edges.begin(), node._edges.end(),
+                                  kind);
+    }
+
+    static _AdjacencyIterator end(const _NodeBase<NodeData, EdgeData> &node,
+                                  const Kind &kind) {
+        return _AdjacencyIterator(node._edges.end(), node._edges.end(), kind);
+    }
+
+    bool atEnd() const {
+        return position_ == end_;
+    }
+
+    void skip() {
+        if (kind_ == kAll)
+            return;
+        while (position_ != end_ &&
+               position_->second.isEdge() != (kind_ == kEdges))
+            ++position_;
+    }
+
+    MapIterator position_, end_;
+    Kind kind_;
+};
+
 // the problem with nodes is the fact they can't be copied
 // this is a wrapper to allow such copying without having to deal with pointers
 template<class NodeData, class EdgeData>
@@ -220,7 +476,7 @@ class NodeWrapperBase {
 
     NodeWrapperBase() {
         if (is_const_object_())
-            internalNode.reset(new NodeType(0));
+            internalNode = _makeHandle<NodeType>(nullptr, 0);
     }
 
     NodeWrapperBase(
@@ -230,12 +486,12 @@ class NodeWrapperBase {
         internalNode = otherNodeWrapper.internalNode;
     }
 
-    explicit NodeWrapperBase(const std::shared_ptr<NodeType> &otherNode) {
+    explicit NodeWrapperBase(const _Handle<NodeType> &otherNode) {
         internalNode = otherNode;
     }
 
-    explicit NodeWrapperBase(const int &index):
-        internalNode(new NodeType(index)) {
+    explicit NodeWrapperBase(const int64_t &index):
+        internalNode(_makeHandle<NodeType>(nullptr, index)) {
     }
 
 
@@ -248,11 +504,11 @@ class NodeWrapperBase {
     void lazyconstruct() const {
         if (!internalNode)  // i'm cheating yes, but i know
                             // it's not a const object, i made sure
-            const_cast<std::shared_ptr<NodeType>&>(internalNode).reset(
-                    new NodeType(0));
+            const_cast<_Handle<NodeType>&>(internalNode) =
+                    _makeHandle<NodeType>(nullptr, 0);
     }
 
-    int& index() const {
+    int64_t& index() const {
         lazyconstruct();
         return internalNode -> index;
     }
@@ -338,15 +594,54 @@ class NodeWrapperBase {
         if (forceSearch)
             return internalNode -> edges();
 
+        if (internalNode->sorted())
+            return std::vector<EdgeType>(internalNode->sorted()->begin(),
+                                         internalNode->sorted()->end());
+
         std::vector<EdgeType> result;
         for (auto &edge : internalNode -> _neighbours)
             result.push_back(edge.second);
-        std::sort(result.begin(), result.end(), [&](const EdgeType& a, const EdgeType& b) {
-            return a.to().index() < b.to().index();
-        });
+        std::sort(result.begin(), result.end(), NodeType::sortedBefore);
         return result;
     }
 
+    typedef _AdjacencyIterator<NodeData, EdgeData> AdjacencyIterator;
+
+    // lazy views of the same things as arcs(false), edges(true) and
+    // arcs(true), in no particular order
+    // don't add or erase edges of this node while going through them
+    Range<AdjacencyIterator> adjacency() const {
+        return range(AdjacencyIterator::kAll);
+    }
+
+    Range<AdjacencyIterator> edgeRange() const {
+        return range(AdjacencyIterator::kEdges);
+    }
+
+    Range<AdjacencyIterator> arcRange() const {
+        return range(AdjacencyIterator::kArcs);
+    }
+
+    typedef typename NodeType::SortedAdjacency::const_iterator
+            SortedIterator;
+
+    // keeps the adjacency sorted by the index of the other end from now on,
+    // adding and erasing edges keep it that way
+    void sortAdjacency() const {
+        lazyconstruct();
+
+        internalNode -> sortAdjacency();
+    }
+
+    // the same as edges(false) without copying or sorting anything
+    // (the first call sorts them once)
+    Range<SortedIterator> sortedAdjacency() const {
+        sortAdjacency();
+
+        return Range<SortedIterator>(internalNode->sorted()->begin(),
+                                     internalNode->sorted()->end());
+    }
+
     typename _Node<NodeData, EdgeData>::DataType data() const {
         lazyconstruct();
 
@@ -371,6 +666,34 @@ class NodeWrapperBase {
     friend class Graph<NodeData, EdgeData>;
     friend class _NodeBase<NodeData, EdgeData>;
 
+    Range<AdjacencyIterator> range(
+            const typename AdjacencyIterator::Kind &kind) const {
+        lazyconstruct();
+
+        return Range<AdjacencyIterator>(
+                AdjacencyIterator::begin(*internalNode, kind),
+                AdjacencyIterator::end(*internalNode, kind));
+    }
+
+    // stores `edge` here, when it's the second half of an edge (the other
+    // end has the same key) both halves are marked as an edge
+    // a self-loop is kept only once
+    EdgeType insert(EdgeType edge, const bool &mirror) const {
+        NodeType *otherNode = edge._to.get();
+        if (mirror && otherNode->_edges.count(edge.getKey())) {
+            if (otherNode == internalNode.get()) {
+                internalNode->setEdge(edge.getKey(), true);
+                return internalNode->_edges.find(edge.getKey())->second;
+            }
+
+            otherNode->setEdge(edge.getKey(), true);
+            edge.setEdge(true);
+        }
+
+        internalNode->store(edge);
+        return edge;
+    }
+
     bool is_const_object_() {
         return false;
     }
@@ -379,7 +702,7 @@ class NodeWrapperBase {
         return true;
     }
 
-    std::shared_ptr<NodeType> internalNode;
+    _Handle<NodeType> internalNode;
 };
 
 template<class NodeData, class EdgeData>
@@ -397,11 +720,11 @@ class NodeWrapper : public NodeWrapperBase<NodeData, EdgeData> {
         NodeWrapperBase<NodeData, EdgeData>(otherNodeWrapper) {
     }
 
-    explicit NodeWrapper(const std::shared_ptr<NodeType> &otherNode):
+    explicit NodeWrapper(const _Handle<NodeType> &otherNode):
         NodeWrapperBase<NodeData, EdgeData>(otherNode) {
     }
 
-    explicit NodeWrapper(const int &index):
+    explicit NodeWrapper(const int64_t &index):
         NodeWrapperBase<NodeData, EdgeData>(index) {
     }
 
@@ -412,30 +735,22 @@ class NodeWrapper : public NodeWrapperBase<NodeData, EdgeData> {
         auto edge = EdgeType(internalNode, otherNodeWrapper.internalNode);
         edge.data() = data;
 
-        internalNode -> _neighbours.insert({otherNodeWrapper.internalNode.get(),
-                                            edge});
-        internalNode -> _edges.insert({edge.getKey(), edge});
-
-        return edge;
+        return insert(edge, false);
     }
 
     EdgeType addEdge(const NodeWrapper& otherNodeWrapper,
-                     const EdgeData& data, const unsigned &key) const {
+                     const EdgeData& data, const uint64_t &key) const {
         lazyconstruct();
         otherNodeWrapper.lazyconstruct();
         auto edge = EdgeType(internalNode, otherNodeWrapper.internalNode, key);
         edge.data() = data;
 
-        internalNode -> _neighbours.insert({otherNodeWrapper.internalNode.get(),
-                                            edge});
-        internalNode -> _edges.insert({edge.getKey(), edge});
-
-        return edge;
+        return insert(edge, true);
     }
 
     EdgeType addEdge(const NodeWrapper& otherNodeWrapper,
-                     const std::shared_ptr<EdgeData>& dataPointer,
-                     const unsigned &key) const {
+                     const typename EdgeType::DataPointer& dataPointer,
+                     const uint64_t &key) const {
         lazyconstruct();
         otherNodeWrapper.lazyconstruct();
         auto edge = EdgeType(internalNode,
@@ -443,11 +758,7 @@ class NodeWrapper : public NodeWrapperBase<NodeData, EdgeData> {
                              key,
                              dataPointer);
 
-        internalNode -> _neighbours.insert({otherNodeWrapper.internalNode.get(),
-                                            edge});
-        internalNode -> _edges.insert({edge.getKey(), edge});
-
-        return edge;
+        return insert(edge, true);
     }
 
   private:
@@ -455,6 +766,7 @@ class NodeWrapper : public NodeWrapperBase<NodeData, EdgeData> {
     friend class _NodeBase<NodeData, EdgeData>;
 
     using NodeWrapperBase<NodeData, EdgeData>::lazyconstruct;
+    using NodeWrapperBase<NodeData, EdgeData>::insert;
     using NodeWrapperBase<NodeData, EdgeData>::internalNode;
 };
 
@@ -474,11 +786,11 @@ class NodeWrapper<NodeData, void> : public NodeWrapperBase<NodeData, void> {
         NodeWrapperBase<NodeData, void>(otherNodeWrapper) {
     }
 
-    explicit NodeWrapper(const std::shared_ptr<NodeType> &otherNode):
+    explicit NodeWrapper(const _Handle<NodeType> &otherNode):
         NodeWrapperBase<NodeData, void>(otherNode) {
     }
 
-    explicit NodeWrapper(const int &index):
+    explicit NodeWrapper(const int64_t &index):
         NodeWrapperBase<NodeData, void>(index) {
     }
 
@@ -488,24 +800,16 @@ class NodeWrapper<NodeData, void> : public NodeWrapperBase<NodeData, void> {
         otherNodeWrapper.lazyconstruct();
         auto edge = EdgeType(internalNode, otherNodeWrapper.internalNode);
 
-        internalNode -> _neighbours.insert({otherNodeWrapper.internalNode.get(),
-                                            edge});
-        internalNode -> _edges.insert({edge.getKey(), edge});
-
-        return edge;
+        return insert(edge, false);
     }
 
     EdgeType addEdge(const NodeWrapper<NodeData, void>& otherNodeWrapper,
-                     const unsigned &key) const {
+                     const uint64_t &key) const {
         lazyconstruct();
         otherNodeWrapper.lazyconstruct();
         auto edge = EdgeType(internalNode, otherNodeWrapper.internalNode, key);
 
-        internalNode -> _neighbours.insert({otherNodeWrapper.internalNode.get(),
-                                            edge});
-        internalNode -> _edges.insert({edge.getKey(), edge});
-
-        return edge;
+        return insert(edge, true);
     }
 
   private:
@@ -513,6 +817,7 @@ class NodeWrapper<NodeData, void> : public NodeWrapperBase<NodeData, void> {
     friend class _NodeBase<NodeData, void>;
 
     using NodeWrapperBase<NodeData, void>::lazyconstruct;
+    using NodeWrapperBase<NodeData, void>::insert;
     using NodeWrapperBase<NodeData, void>::internalNode;
 };
 
@@ -0,0 +1,219 @@
+#ifndef INPUT_GENERATOR_PARALLEL_WRITER_HPP_
+#define INPUT_GENERATOR_PARALLEL_WRITER_HPP_
+
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "exception.hpp"
+#include "boolean.hpp"
+#include "graph.hpp"
+#include "thread_pool.hpp"
+#include "writer.hpp"
+
+namespace inputGenerator {
+
+/**
+ * A Writer that keeps everything in memory, it grows instead of flushing
+ */
+class MemoryWriter : public Writer {
+  public:
+    explicit MemoryWriter(const size_t &reserve = 1 << 16);
+
+    ~MemoryWriter();
+
+    const char* data() const {
+        return memory_.data();
+    }
+
+    size_t size() const {
+        return position_ - begin_;
+    }
+
+    // makes room for more, nothing goes anywhere
+    void flush();
+
+    void writeChunks(const struct iovec *chunks, const size_t &count);
+
+    // forgets what was written and keeps the memory
+    void clear() {
+        position_ = begin_;
+    }
+
+  private:
+    std::vector<char> memory_;
+};
+
+MemoryWriter::MemoryWriter(const size_t &reserve):
+        Writer(-1, false),
+        memory_(std::max<size_t>(reserve, 2 * kMaximumNumber + 2)) {
+    begin_ = position_ = memory_.data();
+    end_ = memory_.data() + memory_.size();
+}
+
+MemoryWriter::~MemoryWriter() {
+    // there's no descriptor for Writer to flush to
+    begin_ = position_ = end_ = nullptr;
+}
+
+void MemoryWriter::flush() {
+    size_t size = position_ - begin_;
+    memory_.resize(2 * memory_.size());
+    begin_ = memory_.data();
+    position_ = begin_ + size;
+    end_ = memory_.data() + memory_.size();
+}
+
+void MemoryWriter::writeChunks(const struct iovec *chunks,
+                               const size_t &count) {
+    for (size_t i = 0; i < count; ++i)
+        write(static_cast<const char*>(chunks[i].iov_base), chunks[i].iov_len);
+}
+
+namespace help {
+    // elements or nodes in one piece, enough that a job is worth handing out
+    static const size_t kChunkItems = 1 << 17;
+
+    // pieces formatted before they're written, a few per thread so slow
+    // ones even out, few enough that memory stays at a couple of MB a thread
+    inline size_t chunksPerRound(const ThreadPool &pool) {
+        return 4 * pool.size();
+    }
+
+    // formats the pieces [0, count) with format(piece, writer) on the pool,
+    // a round at a time, and writes them in order
+    template<class Format>
+    void writeInChunks(Writer &writer, ThreadPool &pool, const size_t &count,
+                       Format format) {
+        std::vector<MemoryWriter> buffers(std::min(count,
+                                                   chunksPerRound(pool)));
+        std::vector<struct iovec> chunks(buffers.size());
+
+        for (size_t round = 0; round < count; round += buffers.size()) {
+            size_t pieces = std::min(buffers.size(), count - round);
+            pool.run(pieces, [&](size_t piece) {
+                buffers[piece].clear();
+                format(round + piece, buffers[piece]);
+            });
+
+            for (size_t piece = 0; piece < pieces; ++piece) {
+                chunks[piece].iov_base =
+                    const_cast<char*>(buffers[piece].data());
+                chunks[piece].iov_len = buffers[piece].size();
+            }
+            writer.writeChunks(chunks.data(), pieces);
+        }
+    }
+}  // namespace help
+
+/**
+ * The serializers of writer.hpp spread over a thread pool, byte for byte the
+ * same output as the ones without a pool
+ */
+
+// for containers with random access, like std::vector
+template<class Container>
+void writeVector(Writer &writer,
+                 const Container &data,
+                 ThreadPool &pool,
+                 const char &separator = ' ') {
+    const size_t size = std::distance(std::begin(data), std::end(data));
+    if (size == 0) {
+        writer.put('\n');
+        return;
+    }
+
+    const size_t chunks = (size + help::kChunkItems - 1) / help::kChunkItems;
+    help::writeInChunks(writer, pool, chunks,
+                        [&](size_t chunk, Writer &output) {
+        size_t first = chunk * help::kChunkItems;
+        size_t last = std::min(size, first + help::kChunkItems);
+        auto element = std::begin(data) + first;
+        for (size_t i = first; i < last; ++i, ++element) {
+            if (i > 0)
+                output.put(separator);
+            output << *element;
+        }
+        if (last == size)
+            output.put('\n');
+    });
+}
+
+template<class NodeData, class EdgeData>
+void writeEdgeList(Writer &writer,
+                   const Graph<NodeData, EdgeData> &graph,
+                   ThreadPool &pool,
+                   Boolean::Object header = Boolean::True) {
+    const size_t nodes = graph.size();
+    const size_t chunks = (nodes + help::kChunkItems - 1) / help::kChunkItems;
+
+    if (header) {
+        std::atomic<int64_t> edges(0);
+        pool.run(chunks, [&](size_t chunk) {
+            int64_t count = 0;
+            for (auto &edge : graph.edgeRange(chunk * help::kChunkItems,
+                                              (chunk + 1) * help::kChunkItems)) {
+                static_cast<void>(edge);
+                ++count;
+            }
+            edges += count;
+        });
+        writer << graph.size() << ' ' << edges.load() << '\n';
+    }
+
+    help::writeInChunks(writer, pool, chunks,
+                        [&](size_t chunk, Writer &output) {
+        for (auto &edge : graph.edgeRange(chunk * help::kChunkItems,
+                                          (chunk + 1) * help::kChunkItems))
+            output(graph.label(edge.fromIndex()),
+                   graph.label(edge.toIndex()));
+    });
+}
+
+template<class NodeData, class EdgeData, class Weight>
+void writeEdgeList(Writer &writer,
+                   const Graph<NodeData, EdgeData> &graph,
+                   const std::vector<Weight> &weights,
+                   ThreadPool &pool,
+                   Boolean::Object header = Boolean::True) {
+    const size_t nodes = graph.size();
+    const size_t chunks = (nodes + help::kChunkItems - 1) / help::kChunkItems;
+
+    // where the weights of every piece start
+    std::vector<size_t> first(chunks + 1, 0);
+    pool.run(chunks, [&](size_t chunk) {
+        size_t count = 0;
+        for (auto &edge : graph.edgeRange(chunk * help::kChunkItems,
+                                          (chunk + 1) * help::kChunkItems)) {
+            static_cast<void>(edge);
+            ++count;
+        }
+        first[chunk + 1] = count;
+    });
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+        first[chunk + 1] += first[chunk];
+#ifdef INPUT_GENERATOR_DEBUG
+    if (first[chunks] > weights.size())
+        throw Exception("writeEdgeList expects a weight for every edge");
+#endif
+
+    if (header)
+        writer << graph.size() << ' ' << weights.size() << '\n';
+
+    help::writeInChunks(writer, pool, chunks,
+                        [&](size_t chunk, Writer &output) {
+        auto weight = weights.begin() + first[chunk];
+        for (auto &edge : graph.edgeRange(chunk * help::kChunkItems,
+                                          (chunk + 1) * help::kChunkItems))
+            output(graph.label(edge.fromIndex()),
+                   graph.label(edge.toIndex()), *weight++);
+    });
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_PARALLEL_WRITER_HPP_
@@ -0,0 +1,39 @@
+#ifndef INPUT_GENERATOR_RANGE_HPP_
+#define INPUT_GENERATOR_RANGE_HPP_
+
+namespace inputGenerator {
+
+/**
+ * A pair of iterators, so lazy views can go in a range-based for
+ * Nothing is copied, the range is only valid while what it looks at is
+ */
+template<class IteratorType>
+class Range {
+  public:
+    typedef IteratorType iterator;
+    typedef IteratorType const_iterator;
+
+    Range(const IteratorType &begin, const IteratorType &end):
+            begin_(begin),
+            end_(end) {
+    }
+
+    IteratorType begin() const {
+        return begin_;
+    }
+
+    IteratorType end() const {
+        return end_;
+    }
+
+    bool empty() const {
+        return begin_ == end_;
+    }
+
+  private:
+    IteratorType begin_, end_;
+};
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_RANGE_HPP_
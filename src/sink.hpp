@@ -0,0 +1,148 @@
+#ifndef INPUT_GENERATOR_SINK_HPP_
+#define INPUT_GENERATOR_SINK_HPP_
+
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "boolean.hpp"
+#include "exception.hpp"
+#include "vectors.hpp"
+
+namespace inputGenerator {
+
+/**
+ * Generators can send their edges straight to a sink instead of building a
+ * Graph. A sink is either something callable as sink(from, to) or an output
+ * iterator of std::pair<int64_t, int64_t> (like std::back_inserter)
+ */
+namespace help {
+    template<class Sink>
+    auto emitEdge(Sink &sink, const int64_t &from, const int64_t &to, int)
+            -> decltype(sink(from, to), void()) {
+        sink(from, to);
+    }
+
+    template<class Sink>
+    void emitEdge(Sink &sink, const int64_t &from, const int64_t &to, long) {
+        *sink = std::make_pair(from, to);
+        ++sink;
+    }
+}  // namespace help
+
+template<class Sink>
+void emitEdge(Sink &sink, const int64_t &from, const int64_t &to) {
+    help::emitEdge(sink, from, to, 0);
+}
+
+/**
+ * The labels Graph::Index would give to the nodes of a generator, computed
+ * up front so the edges can be relabeled as they are made
+ */
+class Relabeling {
+  public:
+    // nothing to relabel
+    Relabeling(): from_(0) {
+    }
+
+    // the identity if `random` is false
+    explicit Relabeling(const int64_t &size,
+                        Boolean::Object random = Boolean::True,
+                        const int64_t &from = 0);
+
+    // some nodes get fixed labels, the rest are random
+    Relabeling(const int64_t &size,
+               std::initializer_list< std::pair<int64_t, int64_t> > fixed,
+               const int64_t &from = 0);
+
+    Relabeling(const int64_t &size,
+               const std::vector< std::pair<int64_t, int64_t> > &fixed,
+               const int64_t &from = 0);
+
+    int64_t operator[](const int64_t &node) const {
+        return labels_.empty() ? from_ + node : labels_[node];
+    }
+
+    // the smallest label
+    const int64_t& from() const {
+        return from_;
+    }
+
+  private:
+    template<class Iterator>
+    void assign(const int64_t &size, Iterator first, Iterator last);
+
+    std::vector<int64_t> labels_;
+    int64_t from_;
+};
+
+Relabeling::Relabeling(const int64_t &size,
+                       Boolean::Object random,
+                       const int64_t &from):
+        from_(from) {
+    if (random)
+        *this = Relabeling(size,
+                           std::initializer_list< std::pair<int64_t, int64_t> >(),
+                           from);
+}
+
+Relabeling::Relabeling(const int64_t &size,
+                       std::initializer_list< std::pair<int64_t, int64_t> > fixed,
+                       const int64_t &from):
+        from_(from) {
+    assign(size, fixed.begin(), fixed.end());
+}
+
+Relabeling::Relabeling(const int64_t &size,
+                       const std::vector< std::pair<int64_t, int64_t> > &fixed,
+                       const int64_t &from):
+        from_(from) {
+    assign(size, fixed.begin(), fixed.end());
+}
+
+template<class Iterator>
+void Relabeling::assign(const int64_t &size, Iterator first, Iterator last) {
+    labels_.assign(size, 0);
+
+    std::vector<bool> usedValue(size, false), fixedNode(size, false);
+    int64_t fixedCount = 0;
+    for (Iterator node = first; node != last; ++node, ++fixedCount) {
+#ifdef INPUT_GENERATOR_DEBUG
+        if (node->first < 0 || node->first >= size)
+            throw Exception("Relabeling expects fixed nodes to be between 0 "
+                            "and `size` - 1");
+
+        if (node->second < from_ || node->second >= from_ + size)
+            throw Exception("Relabeling expects fixed labels to be between "
+                            "`from` and `from` + `size` - 1");
+
+        if (fixedNode[node->first] || usedValue[node->second - from_])
+            throw Exception("Relabeling expects fixed nodes and labels to be"
+                            " distinct");
+#endif
+        labels_[node->first] = node->second;
+        fixedNode[node->first] = true;
+        usedValue[node->second - from_] = true;
+    }
+
+    // exactly the way Graph::Index hands them out
+    std::vector<int64_t> unusedValues;
+    unusedValues.reserve(size - fixedCount);
+    for (int64_t i = 0; i < size; ++i)
+        if (!usedValue[i])
+            unusedValues.push_back(from_ + i);
+    unusedValues = shuffle(std::move(unusedValues));
+
+    for (int64_t i = 0; i < size; ++i) {
+        if (fixedNode[i])
+            continue;
+
+        labels_[i] = unusedValues.back();
+        unusedValues.pop_back();
+    }
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_SINK_HPP_
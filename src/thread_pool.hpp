@@ -0,0 +1,158 @@
+#ifndef INPUT_GENERATOR_THREAD_POOL_HPP_
+#define INPUT_GENERATOR_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace inputGenerator {
+
+/**
+ * A fixed set of threads that run numbered jobs
+ * run(jobs, job) calls job(0) to job(jobs - 1) spread over the threads (the
+ * caller's thread too) and comes back when all of them are done, so nothing
+ * about the order of the jobs is left to chance in what they produce
+ * Nothing random should be drawn inside a job, the generator is not shared
+ */
+class ThreadPool {
+  public:
+    // 0 means one thread per core
+    explicit ThreadPool(const size_t &threads = 0);
+
+    ~ThreadPool();
+
+    // threads that run jobs, the caller's included
+    size_t size() const {
+        return workers_.size() + 1;
+    }
+
+    // the first exception a job throws comes out of here
+    void run(const size_t &jobs, const std::function<void(size_t)> &job);
+
+  private:
+    ThreadPool(const ThreadPool&);
+
+    void operator=(const ThreadPool&);
+
+    void work();
+
+    // runs jobs of the current batch until there are none left
+    void take();
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_, done_;
+
+    const std::function<void(size_t)> *job_;
+    size_t jobs_;
+    std::atomic<size_t> next_;
+    size_t finished_;
+    uint64_t batch_;
+    bool stopping_;
+    std::exception_ptr error_;
+};
+
+ThreadPool::ThreadPool(const size_t &threads):
+        job_(nullptr),
+        jobs_(0),
+        next_(0),
+        finished_(0),
+        batch_(0),
+        stopping_(false) {
+    size_t count = threads;
+    if (count == 0)
+        count = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+
+    workers_.reserve(count - 1);
+    for (size_t i = 1; i < count; ++i)
+        workers_.push_back(std::thread(&ThreadPool::work, this));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker : workers_)
+        worker.join();
+}
+
+void ThreadPool::run(const size_t &jobs,
+                     const std::function<void(size_t)> &job) {
+    if (workers_.empty() || jobs <= 1) {
+        for (size_t i = 0; i < jobs; ++i)
+            job(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        jobs_ = jobs;
+        next_ = 0;
+        finished_ = 0;
+        error_ = std::exception_ptr();
+        ++batch_;
+    }
+    wake_.notify_all();
+
+    take();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() {
+        return finished_ == workers_.size();
+    });
+    job_ = nullptr;
+
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = std::exception_ptr();
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::work() {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, &seen]() {
+                return stopping_ || batch_ != seen;
+            });
+            if (stopping_)
+                return;
+            seen = batch_;
+        }
+
+        take();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (++finished_ == workers_.size())
+            done_.notify_all();
+    }
+}
+
+void ThreadPool::take() {
+    for (size_t i = next_++; i < jobs_; i = next_++) {
+        try {
+            (*job_)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_)
+                error_ = std::current_exception();
+        }
+    }
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_THREAD_POOL_HPP_
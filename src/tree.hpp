@@ -1,34 +1,175 @@
 #ifndef INPUT_GENERATOR_TREE_HPP_
 #define INPUT_GENERATOR_TREE_HPP_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include "exception.hpp"
 #include "boolean.hpp"
 #include "graph.hpp"
 #include "vectors.hpp"
 #include "chain.hpp"
+#include "sink.hpp"
 
 namespace inputGenerator {
 
-// TODO(adrian_budau): use pruffer sequences
+namespace help {
+    // every node from `first` on hangs from a random node before it
+    template<class Emit>
+    void recursiveTreeEdges(const size_t &first,
+                            const size_t &size,
+                            Emit emit) {
+        for (size_t i = first; i < size; ++i)
+            emit(i, randomInt<size_t>(0, i - 1));
+    }
+
+    // decodes a random Prufer sequence, every labeled tree is as likely
+    // the smallest leaf is tracked with a pointer that only moves forward,
+    // so it's O(size) and no heap
+    template<class Emit>
+    void pruferTreeEdges(const size_t &size, Emit emit) {
+        if (size < 2)
+            return;
+
+        std::vector<size_t> sequence(size - 2);
+        std::vector<size_t> degree(size, 1);
+        for (auto &node : sequence) {
+            node = randomInt<size_t>(0, size - 1);
+            ++degree[node];
+        }
+
+        size_t next = 0;
+        while (degree[next] != 1)
+            ++next;
+        size_t leaf = next;
+
+        for (auto &node : sequence) {
+            emit(leaf, node);
+            if (--degree[node] == 1 && node < next) {
+                // it became a leaf behind the pointer, it's the smallest
+                leaf = node;
+            } else {
+                do {
+                    ++next;
+                } while (degree[next] != 1);
+                leaf = next;
+            }
+        }
+        emit(leaf, size - 1);
+    }
+
+    // a chain of `diameter` nodes, then every other node hangs from a random
+    // node that can take it without making a longer path: the i-th node of
+    // the chain can have nodes at most min(i, diameter - 1 - i) below it
+    // (and no node more than `maximumDegree` neighbours, 0 is no limit)
+    // the nodes that can still take one are kept in a vector, the ones that
+    // can't are swapped out of it, so picking one is O(1)
+    template<class Emit>
+    void exactWideTreeEdges(const size_t &size, const size_t &diameter,
+                            const size_t &maximumDegree, Emit emit) {
+        const uint32_t kNoLimit = ~uint32_t(0);
+        const uint32_t degree = maximumDegree == 0 ? kNoLimit :
+                static_cast<uint32_t>(std::min<size_t>(maximumDegree, kNoLimit));
+
+        // how much deeper under a node can go and how many more it can take
+        std::vector<uint32_t> slack(size), room(size);
+        std::vector<size_t> open;
+
+        for (size_t i = 0; i < diameter; ++i) {
+            if (i > 0)
+                emit(i - 1, i);
+            slack[i] = static_cast<uint32_t>(std::min(i, diameter - 1 - i));
+            // the ends of the chain have one neighbour, the others two
+            uint32_t used = i > 0 && i + 1 < diameter ? 2 : 1;
+            room[i] = degree == kNoLimit ? kNoLimit :
+                      degree - std::min(degree, used);
+            if (slack[i] > 0 && room[i] > 0)
+                open.push_back(i);
+        }
+
+        for (size_t i = diameter; i < size; ++i) {
+            if (open.empty())
+                throw Exception("There's no tree with this size, diameter "
+                                "and maximum degree");
+
+            size_t position = randomInt<size_t>(0, open.size() - 1);
+            size_t parent = open[position];
+            emit(parent, i);
+
+            if (room[parent] != kNoLimit && --room[parent] == 0) {
+                open[position] = open.back();
+                open.pop_back();
+            }
+
+            slack[i] = slack[parent] - 1;
+            room[i] = degree == kNoLimit ? kNoLimit : degree - 1;
+            if (slack[i] > 0 && room[i] > 0)
+                open.push_back(i);
+        }
+    }
+}  // namespace help
+
+// uniformly random among all the labeled trees with `size` nodes
 template<class NodeData = void, class EdgeData = void>
 Graph<NodeData, EdgeData> tree(const size_t &size = 1) {
 #ifdef INPUT_GENERATOR_DEBUG
     if (size <= 0)
         throw Exception("Trees must have strictly positive sizes");
 #endif
-    Graph<NodeData, EdgeData> graph;
-    for (size_t i = 1; i < size; ++i) {
-        typename Graph<NodeData, EdgeData>::Node node;
-        typename Graph<NodeData, EdgeData>::Node parent = randomElement(graph);
+    // all nodes are made up front so they come from the graph's arena
+    Graph<NodeData, EdgeData> graph(size);
+    help::pruferTreeEdges(size, [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
 
-        addEdge(node, parent);
-        graph.addNodes({node});
-    }
+    graph.Index();
+    return graph;
+}
+
+// the edges go to `sink` instead, labeled the way Index() would
+template<class Sink>
+void tree(const size_t &size, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Trees must have strictly positive sizes");
+#endif
+    Relabeling labels(size);
+    help::pruferTreeEdges(size, [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+// every node hangs from a random node made before it, these are shallow
+// (O(log size) deep) where uniform trees are O(sqrt(size)) deep
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> recursiveTree(const size_t &size = 1) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Trees must have strictly positive sizes");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::recursiveTreeEdges(1, size, [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
 
     graph.Index();
     return graph;
 }
 
+template<class Sink>
+void recursiveTree(const size_t &size, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Trees must have strictly positive sizes");
+#endif
+    Relabeling labels(size);
+    help::recursiveTreeEdges(1, size, [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
 template<class NodeData = void, class EdgeData = void>
 Graph<NodeData, EdgeData> wideTree(const size_t &size,
                                    const size_t &minimumDiameter,
@@ -48,13 +189,11 @@ Graph<NodeData, EdgeData> wideTree(const size_t &size,
     typename Graph<NodeData, EdgeData>::Node start = graph[0],
                                              end = graph[minimumDiameter - 1];
 
-    for (size_t i = minimumDiameter; i < size; ++i) {
-        typename Graph<NodeData, EdgeData>::Node node;
-        typename Graph<NodeData, EdgeData>::Node parent = randomElement(graph);
-
-        addEdge(node, parent);
-        graph.addNodes({node});
-    }
+    graph.addNodes(size - minimumDiameter);
+    help::recursiveTreeEdges(minimumDiameter, size,
+                             [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
 
     if (randomEnds)
         graph.Index();
@@ -63,6 +202,93 @@ Graph<NodeData, EdgeData> wideTree(const size_t &size,
     return graph;
 }
 
+template<class Sink>
+void wideTree(const size_t &size,
+              const size_t &minimumDiameter,
+              Boolean::Object randomEnds,
+              Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size < 2)
+        throw Exception("Wide trees must have at least two nodes");
+
+    if (minimumDiameter < 2)
+        throw Exception("Wide tree must have the diameter at least two");
+
+    if (size < minimumDiameter)
+        throw Exception("Diameter must be strictly less than the tree size");
+#endif
+    // the ends of the chain are 0 and minimumDiameter - 1
+    int64_t last = minimumDiameter - 1;
+    Relabeling labels = randomEnds ?
+            Relabeling(size) :
+            Relabeling(size, {{0, 0}, {last, 1}});
+
+    auto emit = [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    };
+    help::chainEdges(minimumDiameter, emit);
+    help::recursiveTreeEdges(minimumDiameter, size, emit);
+}
+
+// the longest path has exactly `diameter` nodes (wideTree only promises
+// at least that many) and no node has more than `maximumDegree` neighbours
+// (0 means no limit); the ends of the longest path are labeled 0 and 1 if
+// `randomEnds` is false
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> exactWideTree(const size_t &size,
+                                        const size_t &diameter,
+                                        const size_t &maximumDegree = 0,
+                                        Boolean::Object randomEnds = Boolean::True) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size < 2)
+        throw Exception("Wide trees must have at least two nodes");
+
+    if (diameter < 2)
+        throw Exception("Wide tree must have the diameter at least two");
+
+    if (size < diameter)
+        throw Exception("Diameter must be strictly less than the tree size");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::exactWideTreeEdges(size, diameter, maximumDegree,
+                             [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+
+    if (randomEnds)
+        graph.Index();
+    else
+        graph.Index({{graph[0], 0}, {graph[diameter - 1], 1}});
+    return graph;
+}
+
+template<class Sink>
+void exactWideTree(const size_t &size,
+                   const size_t &diameter,
+                   const size_t &maximumDegree,
+                   Boolean::Object randomEnds,
+                   Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size < 2)
+        throw Exception("Wide trees must have at least two nodes");
+
+    if (diameter < 2)
+        throw Exception("Wide tree must have the diameter at least two");
+
+    if (size < diameter)
+        throw Exception("Diameter must be strictly less than the tree size");
+#endif
+    int64_t last = diameter - 1;
+    Relabeling labels = randomEnds ?
+            Relabeling(size) :
+            Relabeling(size, {{0, 0}, {last, 1}});
+
+    help::exactWideTreeEdges(size, diameter, maximumDegree,
+                             [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
 }  // namespace inputGenerator
 
 #endif  // INPUT_GENERATOR_HPP_
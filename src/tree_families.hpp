@@ -0,0 +1,308 @@
+#ifndef INPUT_GENERATOR_TREE_FAMILIES_HPP_
+#define INPUT_GENERATOR_TREE_FAMILIES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "exception.hpp"
+#include "boolean.hpp"
+#include "graph.hpp"
+#include "numbers.hpp"
+#include "sink.hpp"
+
+namespace inputGenerator {
+
+/**
+ * Trees of a given shape, each one in O(size)
+ * The shape is built on nodes 0 to size - 1 and then labeled at random the
+ * way tree() does it, the ones with a root keep it as node 0 (and every
+ * node where the shape puts it) if `random` is false
+ * Like everywhere else, a sink instead of a graph gets the edges straight
+ */
+
+namespace help {
+    // one center and everything else around it
+    template<class Emit>
+    void starEdges(const size_t &size, Emit emit) {
+        for (size_t i = 1; i < size; ++i)
+            emit(0, i);
+    }
+
+    // a chain of `spine` nodes, the others hang from random nodes of it
+    template<class Emit>
+    void caterpillarEdges(const size_t &size, const size_t &spine,
+                          Emit emit) {
+        for (size_t i = 1; i < spine; ++i)
+            emit(i - 1, i);
+        for (size_t i = spine; i < size; ++i)
+            emit(randomInt<size_t>(0, spine - 1), i);
+    }
+
+    // a chain of `handle` nodes with all the others at its last node
+    template<class Emit>
+    void broomEdges(const size_t &size, const size_t &handle, Emit emit) {
+        for (size_t i = 1; i < handle; ++i)
+            emit(i - 1, i);
+        for (size_t i = handle; i < size; ++i)
+            emit(handle - 1, i);
+    }
+
+    // node i is the child of (i - 1) / arity, as in a heap
+    template<class Emit>
+    void karyTreeEdges(const size_t &size, const size_t &arity, Emit emit) {
+        for (size_t i = 1; i < size; ++i)
+            emit((i - 1) / arity, i);
+    }
+
+    // every node hangs from a random node that still has room
+    // the nodes with room are kept in a vector, a full one is swapped out
+    // of it so picking one is O(1)
+    template<class Emit>
+    void boundedDegreeTreeEdges(const size_t &size, const size_t &maximumDegree,
+                                Emit emit) {
+        std::vector<size_t> open(1, 0), room(size, maximumDegree - 1);
+        room[0] = maximumDegree;
+        for (size_t i = 1; i < size; ++i) {
+            size_t position = randomInt<size_t>(0, open.size() - 1);
+            size_t parent = open[position];
+            emit(parent, i);
+
+            if (--room[parent] == 0) {
+                open[position] = open.back();
+                open.pop_back();
+            }
+            if (room[i] > 0)
+                open.push_back(i);
+        }
+    }
+
+    // rooted at 0 and exactly `height` deep: a chain down to the deepest
+    // node and the others under random nodes that are not on the last level
+    template<class Emit>
+    void heightTreeEdges(const size_t &size, const size_t &height,
+                         Emit emit) {
+        std::vector<size_t> shallow, depth(size, 0);
+        shallow.reserve(size);
+        for (size_t i = 1; i <= height; ++i) {
+            emit(i - 1, i);
+            depth[i] = i;
+            shallow.push_back(i - 1);
+        }
+
+        for (size_t i = height + 1; i < size; ++i) {
+            size_t parent = shallow[randomInt<size_t>(0, shallow.size() - 1)];
+            emit(parent, i);
+            depth[i] = depth[parent] + 1;
+            if (depth[i] < height)
+                shallow.push_back(i);
+        }
+    }
+}  // namespace help
+
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> star(const size_t &size = 1) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Stars must have strictly positive sizes");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::starEdges(size, [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+
+    graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void star(const size_t &size, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Stars must have strictly positive sizes");
+#endif
+    Relabeling labels(size);
+    help::starEdges(size, [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> caterpillar(const size_t &size,
+                                      const size_t &spine) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (spine <= 0 || spine > size)
+        throw Exception("Caterpillars need a spine of at least one node and "
+                        "at most `size` nodes");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::caterpillarEdges(size, spine,
+                           [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+
+    graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void caterpillar(const size_t &size, const size_t &spine, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (spine <= 0 || spine > size)
+        throw Exception("Caterpillars need a spine of at least one node and "
+                        "at most `size` nodes");
+#endif
+    Relabeling labels(size);
+    help::caterpillarEdges(size, spine,
+                           [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> broom(const size_t &size, const size_t &handle) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (handle <= 0 || handle > size)
+        throw Exception("Brooms need a handle of at least one node and at "
+                        "most `size` nodes");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::broomEdges(size, handle, [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+
+    graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void broom(const size_t &size, const size_t &handle, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (handle <= 0 || handle > size)
+        throw Exception("Brooms need a handle of at least one node and at "
+                        "most `size` nodes");
+#endif
+    Relabeling labels(size);
+    help::broomEdges(size, handle, [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+// complete, every level full but the last one which fills from the left
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> karyTree(const size_t &size,
+                                   const size_t &arity,
+                                   Boolean::Object random = Boolean::True) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0 || arity <= 0)
+        throw Exception("K-ary trees must have strictly positive sizes and "
+                        "arities");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::karyTreeEdges(size, arity, [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+
+    if (random)
+        graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void karyTree(const size_t &size, const size_t &arity,
+              Boolean::Object random, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0 || arity <= 0)
+        throw Exception("K-ary trees must have strictly positive sizes and "
+                        "arities");
+#endif
+    Relabeling labels(size, random);
+    help::karyTreeEdges(size, arity, [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+// no node with more than `maximumDegree` neighbours, this is not uniform
+// among all such trees but random enough for tests
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> boundedDegreeTree(const size_t &size,
+                                            const size_t &maximumDegree) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Trees must have strictly positive sizes");
+
+    if (maximumDegree < 2 && size > maximumDegree + 1)
+        throw Exception("Only trees of at most two nodes have no node of "
+                        "degree more than one");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::boundedDegreeTreeEdges(size, maximumDegree,
+                                 [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+
+    graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void boundedDegreeTree(const size_t &size, const size_t &maximumDegree,
+                       Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0)
+        throw Exception("Trees must have strictly positive sizes");
+
+    if (maximumDegree < 2 && size > maximumDegree + 1)
+        throw Exception("Only trees of at most two nodes have no node of "
+                        "degree more than one");
+#endif
+    Relabeling labels(size);
+    help::boundedDegreeTreeEdges(size, maximumDegree,
+                                 [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+// the deepest node is exactly `height` edges from the root
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> heightTree(const size_t &size,
+                                     const size_t &height,
+                                     Boolean::Object random = Boolean::True) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (height >= size)
+        throw Exception("Trees must have more nodes than their height");
+
+    if (height == 0 && size > 1)
+        throw Exception("Only a single node has height zero");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::heightTreeEdges(size, height,
+                          [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
+
+    if (random)
+        graph.Index();
+    return graph;
+}
+
+template<class Sink>
+void heightTree(const size_t &size, const size_t &height,
+                Boolean::Object random, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (height >= size)
+        throw Exception("Trees must have more nodes than their height");
+
+    if (height == 0 && size > 1)
+        throw Exception("Only a single node has height zero");
+#endif
+    Relabeling labels(size, random);
+    help::heightTreeEdges(size, height,
+                          [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, labels[from], labels[to]);
+    });
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_TREE_FAMILIES_HPP_
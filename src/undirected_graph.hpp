@@ -1,6 +1,11 @@
 #ifndef INPUT_GENERATOR_UNDIRECTED_GRAPH_HPP_
 #define INPUT_GENERATOR_UNDIRECTED_GRAPH_HPP_
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
 #include <vector>
 
 #include "exception.hpp"
@@ -8,73 +13,483 @@
 #include "graph.hpp"
 #include "vectors.hpp"
 #include "tree.hpp"
+#include "sink.hpp"
+#include "thread_pool.hpp"
 
 namespace inputGenerator {
 
+namespace help {
+    // `edges` distinct pairs of nodes, in increasing order
+    template<class Emit>
+    void undirectedGraphEdges(const size_t& size,
+                              const size_t& edges,
+                              Emit emit) {
+        int64_t max_edges_number =
+            static_cast<int64_t>(size) * static_cast<int64_t>(size - 1) / 2;
+
+        std::vector<int64_t> edges_ids;
+        if (size > 1)
+            edges_ids =
+                randomSample<int64_t>(edges, 0, max_edges_number - 1);
+
+        size_t node = 0;
+        int64_t from = 0;
+        for (auto &edge_id : edges_ids) {
+            while (edge_id >= int64_t(from + size - node - 1)) {
+                from += size - node - 1;
+                ++node;
+            }
+            emit(node, edge_id - from + node + 1);
+        }
+    }
+
+    // every pair of nodes is an edge with probability `probability`, in
+    // O(size + edges): the gap to the next edge is geometric so it's drawn
+    // in one go (Batagelj and Brandes), the pairs come as (smaller, bigger)
+    // ordered by the bigger one
+    template<class Emit>
+    void binomialGraphEdges(const size_t &size, const double &probability,
+                            Emit emit) {
+        if (size < 2 || probability <= 0)
+            return;
+
+        if (probability >= 1) {
+            for (size_t to = 1; to < size; ++to)
+                for (size_t from = 0; from < to; ++from)
+                    emit(from, to);
+            return;
+        }
+
+        const double logMiss = std::log1p(-probability);
+        const double limit = static_cast<double>(size) * size;
+        std::uniform_real_distribution<double> distribution(0, 1);
+
+        int64_t to = 1, from = -1;
+        while (to < static_cast<int64_t>(size)) {
+            double skip = std::floor(
+                std::log1p(-distribution(Generator::getGenerator())) /
+                logMiss);
+            // a gap past every pair left is the same as the end
+            from += 1 + static_cast<int64_t>(std::min(skip, limit));
+            while (from >= to && to < static_cast<int64_t>(size)) {
+                from -= to;
+                ++to;
+            }
+            if (to < static_cast<int64_t>(size))
+                emit(from, to);
+        }
+    }
+
+    // how many of `sample` drawn without replacement out of `good` + `bad`
+    // are good, exact: drawn one by one for small samples and by Stadlober's
+    // ratio of uniforms (HRUA) otherwise
+    template<class Engine>
+    int64_t randomHypergeometric(Engine &engine, const int64_t &good,
+                                 const int64_t &bad, const int64_t &sample) {
+        const int64_t total = good + bad;
+        std::uniform_real_distribution<double> uniform(0, 1);
+
+        if (sample <= 10 || total - sample <= 10) {
+            int64_t drawn = std::min(sample, total - sample);
+            int64_t remainingTotal = total, remainingGood = good;
+            while (drawn > 0 && remainingGood > 0 &&
+                   remainingTotal > remainingGood) {
+                std::uniform_int_distribution<int64_t> pick(
+                        0, remainingTotal - 1);
+                if (pick(engine) < remainingGood)
+                    --remainingGood;
+                --remainingTotal;
+                --drawn;
+            }
+            if (remainingTotal == remainingGood)
+                remainingGood -= drawn;
+            // if we drew the ones left out, the good ones are what's left
+            return sample > total - sample ? remainingGood
+                                           : good - remainingGood;
+        }
+
+        auto logFactorial = [](const int64_t &value) {
+            return std::lgamma(static_cast<double>(value) + 1);
+        };
+
+        const int64_t drawn = std::min(sample, total - sample);
+        const int64_t fewer = std::min(good, bad), more = std::max(good, bad);
+        const double p = static_cast<double>(fewer) / total;
+        const double q = static_cast<double>(more) / total;
+        const double mean = drawn * p + 0.5;
+        const double spread = std::sqrt(
+            static_cast<double>(total - drawn) * drawn * p * q / (total - 1) +
+            0.5);
+        const double width = 1.7155277699214135 * spread + 0.8989161620588988;
+        const int64_t mode = static_cast<int64_t>(std::floor(
+            static_cast<double>(drawn + 1) * (fewer + 1) / (total + 2)));
+        const double atMode = logFactorial(mode) + logFactorial(fewer - mode) +
+                              logFactorial(drawn - mode) +
+                              logFactorial(more - drawn + mode);
+        const double bound = std::min<double>(
+            std::min(drawn, fewer) + 1, std::floor(mean + 16 * spread));
+
+        int64_t result;
+        while (true) {
+            double u = uniform(engine), v = uniform(engine);
+            if (u == 0)
+                continue;
+            double x = mean + width * (v - 0.5) / u;
+            if (x < 0 || x >= bound)
+                continue;
+
+            result = static_cast<int64_t>(std::floor(x));
+            double t = atMode - (logFactorial(result) +
+                                 logFactorial(fewer - result) +
+                                 logFactorial(drawn - result) +
+                                 logFactorial(more - drawn + result));
+            if (u * (4 - u) - 3 <= t)
+                break;
+            if (u * (u - t) >= 1)
+                continue;
+            if (2 * std::log(u) <= t)
+                break;
+        }
+
+        if (good > bad)
+            result = drawn - result;
+        if (drawn < sample)
+            result = good - result;
+        return result;
+    }
+
+    // sorts numbers between `from` and `to` 11 bits at a time, only as many
+    // bits as the range needs; big samples sort a lot faster than with
+    // std::sort
+    inline void radixSort(std::vector<int64_t> &numbers, const int64_t &from,
+                          const int64_t &to) {
+        if (numbers.size() < (1 << 14)) {
+            std::sort(numbers.begin(), numbers.end());
+            return;
+        }
+
+        const int kBits = 11;
+        const uint64_t range = static_cast<uint64_t>(to - from);
+        std::vector<int64_t> buffer(numbers.size());
+        std::vector<size_t> start(1 << kBits);
+
+        for (int shift = 0; shift < 64 && (shift == 0 || (range >> shift) > 0);
+             shift += kBits) {
+            std::fill(start.begin(), start.end(), 0);
+            for (auto &number : numbers)
+                ++start[(static_cast<uint64_t>(number - from) >> shift) &
+                        ((1 << kBits) - 1)];
+
+            size_t position = 0;
+            for (auto &bucket : start) {
+                size_t size = bucket;
+                bucket = position;
+                position += size;
+            }
+
+            for (auto &number : numbers)
+                buffer[start[(static_cast<uint64_t>(number - from) >> shift) &
+                             ((1 << kBits) - 1)]++] = number;
+            numbers.swap(buffer);
+        }
+    }
+
+    // `count` distinct numbers from [from, to] in increasing order, for
+    // sparse samples: draw with repetition, sort, drop the repeats and draw
+    // as many as were dropped again, that's the same as drawing one by one
+    // until there are `count` different ones so every set is as likely
+    template<class Engine>
+    std::vector<int64_t> sparseSample(Engine &engine, const int64_t &count,
+                                      const int64_t &from, const int64_t &to) {
+        if (2 * count > to - from + 1)
+            return randomSampleWith<int64_t>(engine, count, from, to);
+
+        std::uniform_int_distribution<int64_t> distribution(from, to);
+        std::vector<int64_t> sample, more, merged;
+        sample.reserve(count);
+        while (static_cast<int64_t>(sample.size()) < count) {
+            more.resize(count - sample.size());
+            for (auto &number : more)
+                number = distribution(engine);
+            radixSort(more, from, to);
+
+            merged.resize(sample.size() + more.size());
+            std::merge(sample.begin(), sample.end(), more.begin(), more.end(),
+                       merged.begin());
+            merged.erase(std::unique(merged.begin(), merged.end()),
+                         merged.end());
+            sample.swap(merged);
+        }
+        return sample;
+    }
+
+    // edge ids in a block of consecutive rows (a row is all the pairs
+    // that start at one node) are sampled on their own
+    static const int64_t kBlockEdges = 1 << 20;
+
+    // the same as undirectedGraphEdges, with the ids split in blocks of rows
+    // sampled in parallel; how many edges each block gets is drawn up front
+    // and so is a seed for each block, so the graph only depends on the seed
+    // and not on the pool
+    template<class Emit>
+    void parallelGraphEdges(const size_t &size, const size_t &edges,
+                            ThreadPool &pool, Emit emit) {
+        if (size < 2 || edges == 0)
+            return;
+
+        const int64_t n = size;
+        struct Block {
+            int64_t firstRow, firstId, ids, edges;
+            uint32_t seed[2];
+        };
+
+        // rows with about the same number of ids each
+        const int64_t totalIds = n * (n - 1) / 2;
+        const int64_t blocks = std::max<int64_t>(1,
+            std::min<int64_t>(n - 1, (edges + kBlockEdges - 1) / kBlockEdges));
+        std::vector<Block> block;
+        block.reserve(blocks);
+        int64_t id = 0;
+        for (int64_t row = 0; row < n - 1; ++row) {
+            int64_t made = block.size();
+            if (made == 0 || (made < blocks && id >= totalIds / blocks * made)) {
+                Block next;
+                next.firstRow = row;
+                next.firstId = id;
+                block.push_back(next);
+            }
+            id += n - 1 - row;
+        }
+        for (size_t i = 0; i < block.size(); ++i)
+            block[i].ids = (i + 1 < block.size() ? block[i + 1].firstId
+                                                 : totalIds) -
+                           block[i].firstId;
+
+        int64_t remainingIds = totalIds, remainingEdges = edges;
+        for (auto &part : block) {
+            part.edges = &part == &block.back() ? remainingEdges :
+                randomHypergeometric(Generator::getGenerator(), part.ids,
+                                     remainingIds - part.ids, remainingEdges);
+            remainingIds -= part.ids;
+            remainingEdges -= part.edges;
+            part.seed[0] = Generator::getGenerator()();
+            part.seed[1] = Generator::getGenerator()();
+        }
+
+        // a round of blocks at a time so only that much is in memory
+        const size_t round = 2 * pool.size();
+        std::vector< std::vector< std::pair<int64_t, int64_t> > > found(round);
+        for (size_t first = 0; first < block.size(); first += round) {
+            size_t count = std::min(round, block.size() - first);
+            pool.run(count, [&](size_t job) {
+                const Block &part = block[first + job];
+                std::seed_seq sequence(part.seed, part.seed + 2);
+                std::mt19937 engine(sequence);
+                auto ids = sparseSample(engine, part.edges, part.firstId,
+                                        part.firstId + part.ids - 1);
+
+                auto &output = found[job];
+                output.clear();
+                output.reserve(ids.size());
+                int64_t row = part.firstRow, rowStart = part.firstId;
+                for (auto &edgeId : ids) {
+                    while (edgeId >= rowStart + n - 1 - row) {
+                        rowStart += n - 1 - row;
+                        ++row;
+                    }
+                    output.push_back(std::make_pair(row,
+                                                    edgeId - rowStart + row + 1));
+                }
+            });
+
+            for (size_t job = 0; job < count; ++job)
+                for (auto &edge : found[job])
+                    emit(edge.first, edge.second);
+        }
+    }
+
+    // `taken` (sorted, distinct, all in [0, total)) and `count` more numbers
+    // from [0, total) that are not in it, in increasing order: the k-th
+    // number drawn from the total - taken.size() left is the k-th one that's
+    // not taken, so one walk through both turns one into the other
+    inline std::vector<int64_t> sampleAround(const int64_t &count,
+                                             const int64_t &total,
+                                             std::vector<int64_t> taken) {
+        if (count == 0)
+            return taken;
+
+        const int64_t left = total - static_cast<int64_t>(taken.size());
+        std::vector<int64_t> ids = sparseSample(Generator::getGenerator(),
+                                                count, 0, left - 1);
+        size_t skipped = 0;
+        for (auto &id : ids) {
+            while (skipped < taken.size() &&
+                   taken[skipped] <= id + static_cast<int64_t>(skipped))
+                ++skipped;
+            id += skipped;
+        }
+
+        std::vector<int64_t> all(ids.size() + taken.size());
+        std::merge(ids.begin(), ids.end(), taken.begin(), taken.end(),
+                   all.begin());
+        return all;
+    }
+
+    // a connected graph in O(size + edges): a uniform spanning tree first,
+    // then the other edges sampled around it, pairs are numbered row by row
+    // as in undirectedGraphEdges
+    // the edges come as (smaller, bigger) in increasing order
+    template<class Emit>
+    void connectedGraphEdges(const size_t &size, const size_t &edges,
+                             Emit emit) {
+        if (size < 2)
+            return;
+
+        const int64_t nodes = size;
+        const int64_t pairs = nodes * (nodes - 1) / 2;
+        std::vector<int64_t> treeIds;
+        treeIds.reserve(size - 1);
+        pruferTreeEdges(size, [&](int64_t from, int64_t to) {
+            if (from > to)
+                std::swap(from, to);
+            treeIds.push_back(from * (2 * nodes - from - 1) / 2 + to - from - 1);
+        });
+        radixSort(treeIds, 0, pairs - 1);
+
+        std::vector<int64_t> all = sampleAround(edges - (size - 1), pairs,
+                                                std::move(treeIds));
+
+        int64_t node = 0, rowStart = 0;
+        for (auto &id : all) {
+            while (id >= rowStart + nodes - node - 1) {
+                rowStart += nodes - node - 1;
+                ++node;
+            }
+            emit(node, id - rowStart + node + 1);
+        }
+    }
+}  // namespace help
+
 template<class NodeData = void, class EdgeData = void>
 Graph<NodeData, EdgeData> undirectedGraph(const size_t& size,
                                           const size_t& edges) {
     Graph<NodeData, EdgeData> graph(size);
-    int64_t max_edges_number =
-        static_cast<int64_t>(size) * static_cast<int64_t>(size - 1) / 2;
-
-    std::vector<int64_t> edges_ids;
-    if (size > 1)
-        edges_ids =
-            randomSample<int64_t>(edges, 0, max_edges_number - 1);
-
-    size_t node = 0;
-    int64_t from = 0;
-    for (auto &edge_id : edges_ids) {
-        while (edge_id >= int64_t(from + size - node - 1)) {
-            from += size - node - 1;
-            ++node;
-        }
-        addEdge(graph[node], graph[edge_id - from + node + 1]);
-    }
+    help::undirectedGraphEdges(size, edges,
+                               [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
 
     return graph;
 }
 
+// the edges go to `sink` instead, only the sample itself is kept in memory
+template<class Sink>
+void undirectedGraph(const size_t& size, const size_t& edges, Sink sink) {
+    help::undirectedGraphEdges(size, edges,
+                               [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
+
+// the same kind of graph, made on a thread pool; for a given seed the graph
+// doesn't depend on the pool but it's not the one the overloads without a
+// pool give
 template<class NodeData = void, class EdgeData = void>
 Graph<NodeData, EdgeData> undirectedGraph(const size_t& size,
                                           const size_t& edges,
-                                          Boolean::Object connected) {
-    if (!connected)
-        return undirectedGraph(size, edges);
+                                          ThreadPool &pool) {
+    Graph<NodeData, EdgeData> graph(size);
+    help::parallelGraphEdges(size, edges, pool,
+                             [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
 
-    auto graph = undirectedGraph(size, edges);
-    auto connected_graph = tree(size);
+    return graph;
+}
 
-    // the number of edges we should delete
-    // that's the number of edges that are in in the tree
-    // but not in the normal graph
-    size_t bad_edges = 0;
-    for (auto &edge : connected_graph.edges()) {
-        int x = edge.from().index();
-        int y = edge.to().index();
+template<class Sink>
+void undirectedGraph(const size_t& size, const size_t& edges,
+                     ThreadPool &pool, Sink sink) {
+    help::parallelGraphEdges(size, edges, pool,
+                             [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
 
-        if (graph[x].hasEdge(graph[y]) == false) {
-            ++bad_edges;
-            addEdge(graph[x], graph[y]);
-        }
-    }
+// G(n, p): each pair of nodes is an edge with probability `probability`
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> binomialGraph(const size_t& size,
+                                        const double& probability) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (probability < 0 || probability > 1)
+        throw Exception("binomialGraph expects a probability between 0 and 1");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::binomialGraphEdges(size, probability,
+                             [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
 
-    for (auto &edge : shuffle(graph.edges())) {
-        if (bad_edges == 0)
-            break;
-        int x = edge.from().index();
-        int y = edge.to().index();
+    return graph;
+}
 
-        if (connected_graph[x].hasEdge(connected_graph[y]) == false) {
-            eraseEdge(edge);
-            --bad_edges;
-        }
-    }
+template<class Sink>
+void binomialGraph(const size_t& size, const double& probability, Sink sink) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (probability < 0 || probability > 1)
+        throw Exception("binomialGraph expects a probability between 0 and 1");
+#endif
+    help::binomialGraphEdges(size, probability,
+                             [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
+
+// connected graphs: a random spanning tree plus `edges` - (size - 1) random
+// edges among the pairs it doesn't use; not uniform among connected graphs,
+// the ones with more spanning trees come a bit more often
+template<class NodeData = void, class EdgeData = void>
+Graph<NodeData, EdgeData> undirectedGraph(const size_t& size,
+                                          const size_t& edges,
+                                          Boolean::Object connected) {
+    if (!connected)
+        return undirectedGraph(size, edges);
+
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0 || edges + 1 < size ||
+        edges > static_cast<uint64_t>(size) * (size - 1) / 2)
+        throw Exception("Connected graphs need at least `size` - 1 and at "
+                        "most `size` * (`size` - 1) / 2 edges");
+#endif
+    Graph<NodeData, EdgeData> graph(size);
+    help::connectedGraphEdges(size, edges,
+                              [&](const int64_t &from, const int64_t &to) {
+        addEdge(graph[from], graph[to]);
+    });
 
     return graph;
 }
 
+template<class Sink>
+void undirectedGraph(const size_t& size,
+                     const size_t& edges,
+                     Boolean::Object connected,
+                     Sink sink) {
+    if (!connected)
+        return undirectedGraph(size, edges, sink);
+
+#ifdef INPUT_GENERATOR_DEBUG
+    if (size <= 0 || edges + 1 < size ||
+        edges > static_cast<uint64_t>(size) * (size - 1) / 2)
+        throw Exception("Connected graphs need at least `size` - 1 and at "
+                        "most `size` * (`size` - 1) / 2 edges");
+#endif
+    help::connectedGraphEdges(size, edges,
+                              [&](const int64_t &from, const int64_t &to) {
+        emitEdge(sink, from, to);
+    });
+}
+
 template<class NodeData = void, class EdgeData = void>
 Graph<NodeData, EdgeData> undirectedGraph(
         const size_t& size,
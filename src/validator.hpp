@@ -0,0 +1,465 @@
+#ifndef INPUT_GENERATOR_VALIDATOR_HPP_
+#define INPUT_GENERATOR_VALIDATOR_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+
+namespace inputGenerator {
+
+/**
+ * What a Validator throws when the input is not what it should be, the
+ * message says where
+ */
+class ValidationError: public Exception {
+  public:
+    explicit ValidationError(const std::string &message):
+            Exception(""),
+            text_(message) {
+    }
+
+    virtual const char* what() const throw() {
+        return text_.c_str();
+    }
+
+    virtual ~ValidationError() throw() {}
+
+  private:
+    std::string text_;
+};
+
+/**
+ * The graph made of the edges a Validator read, kept as a CSR (every node's
+ * neighbours next to each other) so the checks go through it in O(n + m)
+ * Edges are undirected, nodes are numbered from `first`
+ */
+class GraphCheck {
+  public:
+    GraphCheck(const int64_t &nodes,
+               std::vector<int64_t> from,
+               std::vector<int64_t> to,
+               const int64_t &first = 1);
+
+    int64_t nodes() const {
+        return offsets_.size() - 1;
+    }
+
+    int64_t edges() const {
+        return from_.size();
+    }
+
+    // union-find over the edges
+    bool connected() const;
+
+    // no cycles, every component a tree
+    bool forest() const;
+
+    bool tree() const {
+        return edges() == nodes() - 1 && connected();
+    }
+
+    // no loops and no edge twice
+    bool simple() const;
+
+    bool bipartite() const;
+
+    // a loop counts twice
+    int64_t degree(const int64_t &node) const {
+        return offsets_[node - first_ + 1] - offsets_[node - first_];
+    }
+
+    int64_t minDegree() const;
+
+    int64_t maxDegree() const;
+
+  private:
+    // the number of components, and whether joining them met a cycle
+    int64_t components(bool &cycle) const;
+
+    int64_t first_;
+    std::vector<int64_t> from_, to_;
+    std::vector<int64_t> offsets_, neighbours_;
+};
+
+GraphCheck::GraphCheck(const int64_t &nodes,
+                       std::vector<int64_t> from,
+                       std::vector<int64_t> to,
+                       const int64_t &first):
+        first_(first),
+        offsets_(nodes + 1, 0) {
+    from_.swap(from);
+    to_.swap(to);
+#ifdef INPUT_GENERATOR_DEBUG
+    if (from_.size() != to_.size())
+        throw Exception("GraphCheck expects as many starts as ends of edges");
+#endif
+    for (auto &node : from_)
+        node -= first_;
+    for (auto &node : to_)
+        node -= first_;
+
+    for (size_t i = 0; i < from_.size(); ++i) {
+        ++offsets_[from_[i] + 1];
+        ++offsets_[to_[i] + 1];
+    }
+    for (int64_t i = 0; i < nodes; ++i)
+        offsets_[i + 1] += offsets_[i];
+
+    neighbours_.resize(2 * from_.size());
+    std::vector<int64_t> next(offsets_.begin(), offsets_.end() - 1);
+    for (size_t i = 0; i < from_.size(); ++i) {
+        neighbours_[next[from_[i]]++] = to_[i];
+        neighbours_[next[to_[i]]++] = from_[i];
+    }
+}
+
+int64_t GraphCheck::components(bool &cycle) const {
+    std::vector<int64_t> parent(nodes()), size(nodes(), 1);
+    for (int64_t i = 0; i < nodes(); ++i)
+        parent[i] = i;
+
+    auto find = [&parent](int64_t node) {
+        while (parent[node] != node) {
+            parent[node] = parent[parent[node]];
+            node = parent[node];
+        }
+        return node;
+    };
+
+    int64_t result = nodes();
+    cycle = false;
+    for (size_t i = 0; i < from_.size(); ++i) {
+        int64_t x = find(from_[i]), y = find(to_[i]);
+        if (x == y) {
+            cycle = true;
+            continue;
+        }
+        // the smaller tree goes under the bigger one
+        if (size[x] < size[y])
+            std::swap(x, y);
+        parent[y] = x;
+        size[x] += size[y];
+        --result;
+    }
+    return result;
+}
+
+bool GraphCheck::connected() const {
+    bool cycle;
+    return nodes() == 0 || components(cycle) == 1;
+}
+
+bool GraphCheck::forest() const {
+    bool cycle;
+    components(cycle);
+    return !cycle;
+}
+
+bool GraphCheck::simple() const {
+    // the last node that saw each node as a neighbour
+    std::vector<int64_t> seenBy(nodes(), -1);
+    for (int64_t node = 0; node < nodes(); ++node)
+        for (int64_t i = offsets_[node]; i < offsets_[node + 1]; ++i) {
+            int64_t neighbour = neighbours_[i];
+            if (neighbour == node || seenBy[neighbour] == node)
+                return false;
+            seenBy[neighbour] = node;
+        }
+    return true;
+}
+
+bool GraphCheck::bipartite() const {
+    std::vector<signed char> side(nodes(), -1);
+    std::vector<int64_t> queue;
+    queue.reserve(nodes());
+
+    for (int64_t start = 0; start < nodes(); ++start) {
+        if (side[start] != -1)
+            continue;
+
+        side[start] = 0;
+        queue.clear();
+        queue.push_back(start);
+        for (size_t at = 0; at < queue.size(); ++at) {
+            int64_t node = queue[at];
+            for (int64_t i = offsets_[node]; i < offsets_[node + 1]; ++i) {
+                int64_t neighbour = neighbours_[i];
+                if (side[neighbour] == side[node])
+                    return false;
+                if (side[neighbour] == -1) {
+                    side[neighbour] = 1 - side[node];
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int64_t GraphCheck::minDegree() const {
+    int64_t result = nodes() == 0 ? 0 : offsets_[1] - offsets_[0];
+    for (int64_t node = 1; node < nodes(); ++node)
+        result = std::min(result, offsets_[node + 1] - offsets_[node]);
+    return result;
+}
+
+int64_t GraphCheck::maxDegree() const {
+    int64_t result = 0;
+    for (int64_t node = 0; node < nodes(); ++node)
+        result = std::max(result, offsets_[node + 1] - offsets_[node]);
+    return result;
+}
+
+/**
+ * Reads a test back and checks it's written exactly the way it should be:
+ * tokens split by one space, lines ending in '\n', nothing after the last
+ * one, numbers with no '+' and no leading zeros
+ * A file is mapped and read in place, anything else (a pipe) is read whole
+ * Every problem is a ValidationError with the line and column
+ */
+class Validator {
+  public:
+    // the standard input by default
+    explicit Validator(const int &fd = 0);
+
+    explicit Validator(const std::string &path);
+
+    ~Validator();
+
+    int64_t readInt(const int64_t &min, const int64_t &max);
+
+    // a run of anything that's not a space or a new line
+    std::string readToken();
+
+    void readSpace();
+
+    void readNewLine();
+
+    // there must be nothing left
+    void readEnd();
+
+    // `count` numbers on one line
+    std::vector<int64_t> readLine(const int64_t &count,
+                                  const int64_t &min, const int64_t &max);
+
+    // `edges` lines "from to", both between `first` and `first` + `nodes` - 1
+    GraphCheck readEdges(const int64_t &nodes, const int64_t &edges,
+                         const int64_t &first = 1);
+
+    // a ValidationError with `message` if `condition` doesn't hold
+    void expect(const bool &condition, const char *message) const {
+        if (!condition)
+            fail(message);
+    }
+
+    // the line we're on, from 1
+    int64_t line() const {
+        return line_;
+    }
+
+  private:
+    Validator(const Validator&);
+
+    void operator=(const Validator&);
+
+    void load(const int &fd);
+
+    void fail(const std::string &message) const;
+
+    void expectCharacter(const char &character, const char *message) {
+        if (position_ == end_ || *position_ != character)
+            fail(message);
+        ++position_;
+    }
+
+    std::vector<char> copy_;
+    char *map_;
+    size_t mapSize_;
+
+    const char *begin_, *position_, *end_, *lineStart_;
+    int64_t line_;
+};
+
+Validator::Validator(const int &fd):
+        map_(nullptr),
+        mapSize_(0) {
+    load(fd);
+}
+
+Validator::Validator(const std::string &path):
+        map_(nullptr),
+        mapSize_(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw Exception("Validator could not open the input file");
+    try {
+        load(fd);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    close(fd);
+}
+
+Validator::~Validator() {
+    if (map_ != nullptr)
+        munmap(map_, mapSize_);
+}
+
+void Validator::load(const int &fd) {
+    struct stat status;
+    if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) &&
+            status.st_size > 0) {
+        mapSize_ = status.st_size;
+        void *map = mmap(nullptr, mapSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            map_ = static_cast<char*>(map);
+            madvise(map_, mapSize_, MADV_SEQUENTIAL);
+            begin_ = map_;
+            end_ = map_ + mapSize_;
+            position_ = lineStart_ = begin_;
+            line_ = 1;
+            return;
+        }
+        mapSize_ = 0;
+    }
+
+    // not something we can map, it's read in one piece
+    size_t size = 0;
+    copy_.resize(1 << 16);
+    while (true) {
+        if (size == copy_.size())
+            copy_.resize(2 * copy_.size());
+        ssize_t done = read(fd, copy_.data() + size, copy_.size() - size);
+        if (done < 0) {
+            if (errno == EINTR)
+                continue;
+            throw Exception("Validator could not read the input");
+        }
+        if (done == 0)
+            break;
+        size += done;
+    }
+
+    begin_ = copy_.data();
+    end_ = begin_ + size;
+    position_ = lineStart_ = begin_;
+    line_ = 1;
+}
+
+void Validator::fail(const std::string &message) const {
+    throw ValidationError("line " + std::to_string(line_) + ", column " +
+                          std::to_string(position_ - lineStart_ + 1) + ": " +
+                          message);
+}
+
+int64_t Validator::readInt(const int64_t &min, const int64_t &max) {
+    const char *start = position_;
+    bool negative = false;
+    if (position_ != end_ && *position_ == '-') {
+        negative = true;
+        ++position_;
+    }
+
+    if (position_ == end_ || *position_ < '0' || *position_ > '9') {
+        position_ = start;
+        fail("expected a number");
+    }
+    if (*position_ == '0' && position_ + 1 != end_ &&
+            position_[1] >= '0' && position_[1] <= '9') {
+        position_ = start;
+        fail("a number can't have leading zeros");
+    }
+
+    // the magnitude of the smallest int64_t is one more than the biggest
+    const uint64_t limit = (uint64_t(1) << 63) - (negative ? 0 : 1);
+    uint64_t value = 0;
+    while (position_ != end_ && *position_ >= '0' && *position_ <= '9') {
+        unsigned digit = *position_ - '0';
+        if (value > (limit - digit) / 10) {
+            position_ = start;
+            fail("the number doesn't fit in 64 bits");
+        }
+        value = value * 10 + digit;
+        ++position_;
+    }
+
+    if (negative && value == 0) {
+        position_ = start;
+        fail("zero can't have a sign");
+    }
+
+    int64_t result = negative ? static_cast<int64_t>(0 - value)
+                              : static_cast<int64_t>(value);
+    if (result < min || result > max) {
+        position_ = start;
+        fail("the number " + std::to_string(result) + " is not between " +
+             std::to_string(min) + " and " + std::to_string(max));
+    }
+    return result;
+}
+
+std::string Validator::readToken() {
+    const char *start = position_;
+    while (position_ != end_ && *position_ != ' ' && *position_ != '\n' &&
+           *position_ != '\r' && *position_ != '\t')
+        ++position_;
+    if (start == position_)
+        fail("expected a token");
+    return std::string(start, position_);
+}
+
+void Validator::readSpace() {
+    expectCharacter(' ', "expected a space");
+}
+
+void Validator::readNewLine() {
+    expectCharacter('\n', "expected a new line");
+    ++line_;
+    lineStart_ = position_;
+}
+
+void Validator::readEnd() {
+    if (position_ != end_)
+        fail("expected the end of the input");
+}
+
+std::vector<int64_t> Validator::readLine(const int64_t &count,
+                                         const int64_t &min,
+                                         const int64_t &max) {
+    std::vector<int64_t> result(count);
+    for (int64_t i = 0; i < count; ++i) {
+        if (i > 0)
+            readSpace();
+        result[i] = readInt(min, max);
+    }
+    readNewLine();
+    return result;
+}
+
+GraphCheck Validator::readEdges(const int64_t &nodes, const int64_t &edges,
+                                const int64_t &first) {
+    std::vector<int64_t> from(edges), to(edges);
+    const int64_t last = first + nodes - 1;
+    for (int64_t i = 0; i < edges; ++i) {
+        from[i] = readInt(first, last);
+        readSpace();
+        to[i] = readInt(first, last);
+        readNewLine();
+    }
+    return GraphCheck(nodes, std::move(from), std::move(to), first);
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_VALIDATOR_HPP_
@@ -0,0 +1,342 @@
+#ifndef INPUT_GENERATOR_VARIANT_HPP_
+#define INPUT_GENERATOR_VARIANT_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+#include "boolean.hpp"
+#include "edge.hpp"
+#include "flat_set.hpp"
+#include "graph.hpp"
+#include "sink.hpp"
+
+namespace inputGenerator {
+
+namespace help {
+    // what a variant keeps for the data of an edge, graphs without edge data
+    // just carry a dummy
+    template<class EdgeData>
+    struct VariantData {
+        typedef EdgeData type;
+
+        template<class NodeData>
+        static const EdgeData& of(const _Edge<NodeData, EdgeData> &edge) {
+            return edge.data();
+        }
+
+        template<class NodeData>
+        static void add(const NodeWrapper<NodeData, EdgeData> &from,
+                        const NodeWrapper<NodeData, EdgeData> &to,
+                        const EdgeData &data, const bool &isArc) {
+            if (isArc)
+                from.addEdge(to, data);
+            else
+                ::inputGenerator::addEdge(from, to, data);
+        }
+    };
+
+    template<>
+    struct VariantData<void> {
+        typedef bool type;
+
+        template<class NodeData>
+        static const bool& of(const _Edge<NodeData, void>&) {
+            static const bool none = false;
+            return none;
+        }
+
+        template<class NodeData>
+        static void add(const NodeWrapper<NodeData, void> &from,
+                        const NodeWrapper<NodeData, void> &to,
+                        const bool&, const bool &isArc) {
+            if (isArc)
+                from.addEdge(to);
+            else
+                ::inputGenerator::addEdge(from, to);
+        }
+    };
+}  // namespace help
+
+/**
+ * A graph written down as the changes from a base graph it shares with all
+ * its siblings, so making a variant costs as much as what changes in it
+ * The base is never touched, edges are added and erased, their data changed
+ * and the nodes relabeled only in the variant
+ * Edges are told apart by their keys, the ones of the base or the ones
+ * addEdge gives back
+ */
+template<class NodeData = void, class EdgeData = void>
+class GraphVariant {
+  public:
+    typedef Graph<NodeData, EdgeData> GraphType;
+    typedef _Edge<NodeData, EdgeData> EdgeType;
+    typedef typename help::VariantData<EdgeData>::type DataType;
+
+    explicit GraphVariant(const GraphType &base);
+
+    explicit GraphVariant(GraphType &&base);
+
+    // a sibling with the same changes, later changes don't go back and forth
+    GraphVariant variant() const {
+        return *this;
+    }
+
+    // indexes are the ones of the base graph, before any relabeling
+    uint64_t addEdge(const int64_t &from, const int64_t &to,
+                     const DataType &data = DataType());
+
+    uint64_t addArc(const int64_t &from, const int64_t &to,
+                    const DataType &data = DataType());
+
+    // false if it was already erased here
+    bool eraseEdge(const uint64_t &key);
+
+    bool eraseEdge(const EdgeType &edge) {
+        return eraseEdge(edge.getKey());
+    }
+
+    void setData(const uint64_t &key, const DataType &data);
+
+    void setData(const EdgeType &edge, const DataType &data) {
+        setData(edge.getKey(), data);
+    }
+
+    // a fresh random labeling, as Graph::Index
+    void Index(const int64_t &from = 0);
+
+    // the nodes labeled `first` and `second` trade labels
+    void swapLabels(const int64_t &first, const int64_t &second);
+
+    // what the node indexed `index` in the base is called here
+    int64_t label(const int64_t &index) const;
+
+    int64_t size() const {
+        return base_->size();
+    }
+
+    int64_t min() const {
+        return labelStart_;
+    }
+
+    int64_t max() const {
+        return labelStart_ + size() - 1;
+    }
+
+    // visit(from, to, data) for every edge, with the labels of this variant
+    template<class Visitor>
+    void forEachEdge(Visitor visit) const {
+        forEach(base_->edgeRange(), false, visit);
+    }
+
+    template<class Visitor>
+    void forEachArc(Visitor visit) const {
+        forEach(base_->arcRange(), true, visit);
+    }
+
+    // the edges as pairs of labels, see sink.hpp
+    template<class Sink>
+    void edges(Sink sink) const {
+        forEachEdge([&](const int64_t &from, const int64_t &to,
+                        const DataType&) {
+            emitEdge(sink, from, to);
+        });
+    }
+
+    // a real graph with all the changes, this one is O(n + m)
+    GraphType graph() const;
+
+    const GraphType& base() const {
+        return *base_;
+    }
+
+  private:
+    struct AddedEdge {
+        int64_t from, to;
+        uint64_t key;
+        bool isArc;
+    };
+
+    uint64_t add(const int64_t &from, const int64_t &to,
+                 const DataType &data, const bool &isArc);
+
+    template<class EdgeRange, class Visitor>
+    void forEach(const EdgeRange &range, const bool &arcs,
+                 Visitor visit) const;
+
+    std::shared_ptr<const GraphType> base_;
+
+    std::vector<AddedEdge> added_;
+    std::vector<DataType> addedData_;
+    FlatSet erased_;
+    std::unordered_map<uint64_t, DataType> changedData_;
+
+    // a new labeling of the whole graph (only after Index)
+    std::shared_ptr<const Relabeling> labels_;
+    int64_t labelStart_;
+
+    // labels that were swapped since, both ways
+    std::unordered_map<int64_t, int64_t> swappedTo_, swappedFrom_;
+};
+
+template<class NodeData, class EdgeData>
+GraphVariant<NodeData, EdgeData>::GraphVariant(const GraphType &base):
+        base_(std::make_shared<const GraphType>(base)),
+        labelStart_(base.min()) {
+}
+
+template<class NodeData, class EdgeData>
+GraphVariant<NodeData, EdgeData>::GraphVariant(GraphType &&base):
+        base_(std::make_shared<const GraphType>(std::move(base))),
+        labelStart_(base_->min()) {
+}
+
+template<class NodeData, class EdgeData>
+uint64_t GraphVariant<NodeData, EdgeData>::add(const int64_t &from,
+                                               const int64_t &to,
+                                               const DataType &data,
+                                               const bool &isArc) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (from < base_->min() || from > base_->max() ||
+            to < base_->min() || to > base_->max())
+        throw Exception("GraphVariant expects edges between nodes of the "
+                        "base graph");
+#endif
+    AddedEdge edge;
+    edge.from = from;
+    edge.to = to;
+    edge.key = _EdgeKeys::next();
+    edge.isArc = isArc;
+
+    added_.push_back(edge);
+    addedData_.push_back(data);
+    return edge.key;
+}
+
+template<class NodeData, class EdgeData>
+uint64_t GraphVariant<NodeData, EdgeData>::addEdge(const int64_t &from,
+                                                   const int64_t &to,
+                                                   const DataType &data) {
+    return add(from, to, data, false);
+}
+
+template<class NodeData, class EdgeData>
+uint64_t GraphVariant<NodeData, EdgeData>::addArc(const int64_t &from,
+                                                  const int64_t &to,
+                                                  const DataType &data) {
+    return add(from, to, data, true);
+}
+
+template<class NodeData, class EdgeData>
+bool GraphVariant<NodeData, EdgeData>::eraseEdge(const uint64_t &key) {
+    changedData_.erase(key);
+    return erased_.insert(key);
+}
+
+template<class NodeData, class EdgeData>
+void GraphVariant<NodeData, EdgeData>::setData(const uint64_t &key,
+                                               const DataType &data) {
+    changedData_[key] = data;
+}
+
+template<class NodeData, class EdgeData>
+void GraphVariant<NodeData, EdgeData>::Index(const int64_t &from) {
+    labels_ = std::make_shared<const Relabeling>(size(), Boolean::True, from);
+    labelStart_ = from;
+    swappedTo_.clear();
+    swappedFrom_.clear();
+}
+
+template<class NodeData, class EdgeData>
+void GraphVariant<NodeData, EdgeData>::swapLabels(const int64_t &first,
+                                                  const int64_t &second) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (first < min() || first > max() || second < min() || second > max())
+        throw Exception("GraphVariant::swapLabels expects labels between "
+                        "min() and max()");
+#endif
+    // the labels the two nodes had before any swap
+    auto firstFound = swappedFrom_.find(first);
+    auto secondFound = swappedFrom_.find(second);
+    int64_t firstOwner =
+        firstFound == swappedFrom_.end() ? first : firstFound->second;
+    int64_t secondOwner =
+        secondFound == swappedFrom_.end() ? second : secondFound->second;
+
+    swappedTo_[firstOwner] = second;
+    swappedFrom_[second] = firstOwner;
+    swappedTo_[secondOwner] = first;
+    swappedFrom_[first] = secondOwner;
+}
+
+template<class NodeData, class EdgeData>
+int64_t GraphVariant<NodeData, EdgeData>::label(const int64_t &index) const {
+    int64_t result = labels_ ? (*labels_)[index - base_->min()]
+                             : base_->label(index);
+    if (swappedTo_.empty())
+        return result;
+
+    auto swapped = swappedTo_.find(result);
+    return swapped == swappedTo_.end() ? result : swapped->second;
+}
+
+template<class NodeData, class EdgeData>
+template<class EdgeRange, class Visitor>
+void GraphVariant<NodeData, EdgeData>::forEach(const EdgeRange &range,
+                                               const bool &arcs,
+                                               Visitor visit) const {
+    for (auto &edge : range) {
+        if (!erased_.empty() && erased_.count(edge.getKey()))
+            continue;
+
+        if (!changedData_.empty()) {
+            auto changed = changedData_.find(edge.getKey());
+            if (changed != changedData_.end()) {
+                visit(label(edge.fromIndex()), label(edge.toIndex()),
+                      changed->second);
+                continue;
+            }
+        }
+
+        visit(label(edge.fromIndex()), label(edge.toIndex()),
+              help::VariantData<EdgeData>::of(edge));
+    }
+
+    for (size_t i = 0; i < added_.size(); ++i) {
+        const AddedEdge &edge = added_[i];
+        if (edge.isArc != arcs)
+            continue;
+        if (!erased_.empty() && erased_.count(edge.key))
+            continue;
+
+        auto changed = changedData_.find(edge.key);
+        visit(label(edge.from), label(edge.to),
+              changed == changedData_.end() ? addedData_[i] : changed->second);
+    }
+}
+
+template<class NodeData, class EdgeData>
+Graph<NodeData, EdgeData> GraphVariant<NodeData, EdgeData>::graph() const {
+    GraphType result(size(), min());
+
+    forEachEdge([&](const int64_t &from, const int64_t &to,
+                    const DataType &data) {
+        help::VariantData<EdgeData>::add(result[from], result[to], data,
+                                         false);
+    });
+
+    forEachArc([&](const int64_t &from, const int64_t &to,
+                   const DataType &data) {
+        help::VariantData<EdgeData>::add(result[from], result[to], data,
+                                         true);
+    });
+
+    return result;
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_VARIANT_HPP_
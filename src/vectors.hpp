@@ -1,7 +1,7 @@
 #ifndef INPUT_GENERATOR_VECTORS_HPP_
 #define INPUT_GENERATOR_VECTORS_HPP_
 
-#include <unordered_set>
+#include <cmath>
 #include <random>
 #include <set>
 #include <utility>
@@ -11,6 +11,7 @@
 
 #include "boolean.hpp"
 #include "exception.hpp"
+#include "flat_set.hpp"
 #include "generator.hpp"
 #include "numbers.hpp"
 
@@ -78,6 +79,48 @@ DataType randomElement(std::initializer_list<DataType> data) {
     return randomElement(data.begin(), data.end());
 }
 
+namespace help {
+    // randomSample with a generator of our choice, the same numbers come
+    // out of the same generator
+    template<class IntType, class Engine>
+    std::vector<IntType> randomSampleWith(Engine &engine,
+                                          const size_t& numbers,
+                                          const IntType& from,
+                                          const IntType& to) {
+        if (numbers == 0)
+            return std::vector<IntType>();
+
+        if (to - from + 1 == IntType(numbers)) {
+            std::vector<IntType> sample(numbers);
+            for (size_t i = 0; i < numbers; ++i)
+                sample[i] = from + i;
+            return sample;
+        }
+
+        // numbers are kept as their distance from `from`
+        FlatSet takenNumbers(numbers);
+        std::vector<IntType> sample;
+        sample.reserve(numbers);  // for some extra speed
+
+        for (size_t taken = 1; taken <= numbers; ++taken) {
+            // long live "Programming Pearls"
+            std::uniform_int_distribution<IntType> distribution(
+                    from, to - numbers + taken);
+            IntType toTake = distribution(engine);
+            if (!takenNumbers.insert(static_cast<uint64_t>(toTake) -
+                                     static_cast<uint64_t>(from))) {
+                toTake = to - numbers + taken;
+                takenNumbers.insert(static_cast<uint64_t>(toTake) -
+                                    static_cast<uint64_t>(from));
+            }
+            sample.push_back(toTake);
+        }
+
+        sort(sample.begin(), sample.end());
+        return sample;
+    }
+}  // namespace help
+
 template<class IntType = int>
 std::vector<IntType> randomSample(
         const size_t& numbers,
@@ -91,35 +134,68 @@ std::vector<IntType> randomSample(
         throw Exception("randomSample expects `numbers` to be at most the"
                         " number of elements in the interval");
 #endif
+    return help::randomSampleWith(Generator::getGenerator(), numbers, from,
+                                  to);
+}
 
-    if (numbers == 0)
-        return std::vector<IntType>();
-
-    if (to - from + 1 == IntType(numbers)) {
-        std::vector<IntType> sample(numbers);
-        for (size_t i = 0; i < numbers; ++i)
-            sample[i] = from + i;
-        return sample;
-    }
-
-    std::unordered_set<IntType> takenNumbers;
-    std::vector<IntType> sample;
-    sample.reserve(numbers);  // for some extra speed
+// `numbers` values from [from, to], repeats allowed, one distribution for
+// all of them
+template<class IntType = int>
+std::vector<IntType> randomInts(
+        const size_t& numbers,
+        const IntType& from = std::numeric_limits<IntType>::min(),
+        const IntType& to = std::numeric_limits<IntType>::max()) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (from > to)
+        throw Exception("randomInts expects `from` to be at most `to`");
+#endif
+    std::uniform_int_distribution<IntType> distribution(from, to);
+    auto &generator = Generator::getGenerator();
+    std::vector<IntType> result(numbers);
+    for (auto &number : result)
+        number = distribution(generator);
+    return result;
+}
 
-    for (size_t taken = 1; taken <= numbers; ++taken) {
-        // long live "Programming Pearls"
-        IntType toTake = randomInt<IntType>(from, to - numbers + taken);
-        if (takenNumbers.find(toTake) == takenNumbers.end()) {
-            sample.push_back(toTake);
-            takenNumbers.insert(toTake);
-        } else {
-            sample.push_back(to - numbers + taken);
-            takenNumbers.insert(to - numbers + taken);
-        }
-    }
+template<class RealType = double>
+std::vector<RealType> randomReals(const size_t& numbers,
+                                  const RealType& from = 0,
+                                  const RealType& to = 1) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (from >= to)
+        throw Exception("randomReals expects `from` to be strictly lower than "
+                        "`to`");
+#endif
+    std::uniform_real_distribution<RealType> distribution(from, to);
+    auto &generator = Generator::getGenerator();
+    std::vector<RealType> result(numbers);
+    for (auto &number : result)
+        number = distribution(generator);
+    return result;
+}
 
-    sort(sample.begin(), sample.end());
-    return sample;
+// `numbers` values from [from, to], k comes with probability proportional
+// to k^-exponent (both ends must be strictly positive)
+template<class IntType = int>
+std::vector<IntType> randomPowerLaw(const size_t& numbers,
+                                    const double& exponent,
+                                    const IntType& from,
+                                    const IntType& to) {
+#ifdef INPUT_GENERATOR_DEBUG
+    if (from <= 0 || from > to)
+        throw Exception("randomPowerLaw expects 0 < `from` <= `to`");
+#endif
+    std::vector<double> weights(to - from + 1);
+    for (IntType value = from; value <= to; ++value)
+        weights[value - from] = std::pow(static_cast<double>(value), -exponent);
+
+    std::discrete_distribution<size_t> distribution(weights.begin(),
+                                                    weights.end());
+    auto &generator = Generator::getGenerator();
+    std::vector<IntType> result(numbers);
+    for (auto &number : result)
+        number = from + static_cast<IntType>(distribution(generator));
+    return result;
 }
 
 template<class Container>
@@ -0,0 +1,471 @@
+#ifndef INPUT_GENERATOR_WRITER_HPP_
+#define INPUT_GENERATOR_WRITER_HPP_
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "exception.hpp"
+#include "boolean.hpp"
+#include "graph.hpp"
+
+namespace inputGenerator {
+
+namespace help {
+    // "00" to "99", two digits at a time is about twice as fast
+    static const char kDigitPairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    inline int digits(uint64_t value) {
+        int result = 1;
+        while (true) {
+            if (value < 10) return result;
+            if (value < 100) return result + 1;
+            if (value < 1000) return result + 2;
+            if (value < 10000) return result + 3;
+            value /= 10000;
+            result += 4;
+        }
+    }
+
+    // how many characters formatNumber writes
+    template<class IntType>
+    int formattedSize(const IntType &value) {
+        if (std::is_signed<IntType>::value && value < 0)
+            return 1 + digits(-static_cast<uint64_t>(value));
+        return digits(static_cast<uint64_t>(value));
+    }
+
+    // writes `value` at `out` and returns where it ended, no terminator
+    inline char* formatUnsigned(char *out, uint64_t value) {
+        int length = digits(value);
+        char *end = out + length;
+        char *position = end;
+        while (value >= 100) {
+            unsigned pair = static_cast<unsigned>(value % 100) * 2;
+            value /= 100;
+            *--position = kDigitPairs[pair + 1];
+            *--position = kDigitPairs[pair];
+        }
+        if (value >= 10) {
+            unsigned pair = static_cast<unsigned>(value) * 2;
+            *--position = kDigitPairs[pair + 1];
+            *--position = kDigitPairs[pair];
+        } else {
+            *--position = static_cast<char>('0' + value);
+        }
+        return end;
+    }
+
+    template<class IntType>
+    char* formatNumber(char *out, const IntType &value) {
+        if (std::is_signed<IntType>::value && value < 0) {
+            *out++ = '-';
+            return formatUnsigned(out, -static_cast<uint64_t>(value));
+        }
+        return formatUnsigned(out, static_cast<uint64_t>(value));
+    }
+}  // namespace help
+
+/**
+ * Buffered output straight to a file descriptor with write(2)
+ * Numbers are formatted by hand, there's no locale and no stream state
+ * Everything goes out when the buffer fills, on flush() and when the writer
+ * dies
+ * It's also an edge sink (see sink.hpp): writer(from, to) prints "from to",
+ * generators take sinks by value so give them std::ref(writer)
+ */
+class Writer {
+  public:
+    static const size_t kDefaultBuffer = 1 << 22;
+
+    explicit Writer(const int &fd = 1,
+                    const size_t &bufferSize = kDefaultBuffer);
+
+    // creates (or truncates) the file
+    explicit Writer(const std::string &path,
+                    const size_t &bufferSize = kDefaultBuffer);
+
+    virtual ~Writer();
+
+    Writer& put(const char &character) {
+        if (position_ == end_)
+            flush();
+        *position_++ = character;
+        return *this;
+    }
+
+    Writer& write(const char *data, size_t size);
+
+    Writer& write(const std::string &data) {
+        return write(data.data(), data.size());
+    }
+
+    Writer& write(const char *data) {
+        return write(data, std::strlen(data));
+    }
+
+    template<class IntType>
+    typename std::enable_if<std::is_integral<IntType>::value, Writer&>::type
+    write(const IntType &value) {
+        if (end_ - position_ < kMaximumNumber)
+            flush();
+        position_ = help::formatNumber(position_, value);
+        return *this;
+    }
+
+    // fixed notation with `precision` decimals
+    Writer& write(const double &value, const int &precision = 6);
+
+    template<class Type>
+    Writer& operator<<(const Type &value) {
+        return write(value);
+    }
+
+    Writer& operator<<(const char &character) {
+        return put(character);
+    }
+
+    // edge sink
+    void operator()(const int64_t &from, const int64_t &to) {
+        if (end_ - position_ < 2 * kMaximumNumber + 2)
+            flush();
+        position_ = help::formatNumber(position_, from);
+        *position_++ = ' ';
+        position_ = help::formatNumber(position_, to);
+        *position_++ = '\n';
+    }
+
+    // weighted edge sink, "from to weight"
+    template<class Weight>
+    void operator()(const int64_t &from, const int64_t &to,
+                    const Weight &weight) {
+        write(from).put(' ').write(to).put(' ');
+        *this << weight;
+        put('\n');
+    }
+
+    // sends what's buffered on and makes room for more
+    virtual void flush();
+
+    // pieces formatted somewhere else, written in order after what's
+    // buffered, one writev(2) for all of them
+    virtual void writeChunks(const struct iovec *chunks, const size_t &count);
+
+    // bytes handed to the writer so far
+    uint64_t written() const {
+        return flushed_ + (position_ - begin_);
+    }
+
+  protected:
+    // a 64-bit number with its sign
+    static const int kMaximumNumber = 21;
+
+    // for writers that bring their own memory to format into, they point
+    // begin_, position_ and end_ at it in flush()
+    Writer(const int &fd, const bool &ownsFd);
+
+    // where the formatted bytes go, by default write(2) on our descriptor
+    // writers that change it should change writeChunks too
+    virtual void drain(const char *data, size_t size);
+
+    // all the chunks to our descriptor with writev(2), nothing is counted
+    void drainChunks(const struct iovec *chunks, const size_t &count);
+
+    int fd_;
+    bool ownsFd_;
+
+    // written() is flushed_ plus what's between begin_ and position_
+    char *begin_, *position_, *end_;
+    uint64_t flushed_;
+
+  private:
+    Writer(const Writer&);
+
+    void operator=(const Writer&);
+
+    std::vector<char> buffer_;
+};
+
+const size_t Writer::kDefaultBuffer;
+const int Writer::kMaximumNumber;
+
+Writer::Writer(const int &fd, const size_t &bufferSize):
+        fd_(fd),
+        ownsFd_(false),
+        flushed_(0),
+        buffer_(std::max<size_t>(bufferSize, 2 * kMaximumNumber + 2)) {
+    begin_ = position_ = buffer_.data();
+    end_ = buffer_.data() + buffer_.size();
+}
+
+Writer::Writer(const std::string &path, const size_t &bufferSize):
+        fd_(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+        ownsFd_(true),
+        flushed_(0),
+        buffer_(std::max<size_t>(bufferSize, 2 * kMaximumNumber + 2)) {
+    if (fd_ < 0)
+        throw Exception("Writer could not open the output file");
+    begin_ = position_ = buffer_.data();
+    end_ = buffer_.data() + buffer_.size();
+}
+
+Writer::Writer(const int &fd, const bool &ownsFd):
+        fd_(fd),
+        ownsFd_(ownsFd),
+        begin_(nullptr),
+        position_(nullptr),
+        end_(nullptr),
+        flushed_(0) {
+}
+
+Writer::~Writer() {
+    // derived writers flush on their own, this only catches what's ours
+    try {
+        flush();
+    } catch (...) {
+    }
+    if (ownsFd_)
+        close(fd_);
+}
+
+Writer& Writer::write(const char *data, size_t size) {
+    while (size > 0) {
+        if (position_ == end_)
+            flush();
+        size_t chunk = std::min<size_t>(size, end_ - position_);
+        std::memcpy(position_, data, chunk);
+        position_ += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return *this;
+}
+
+Writer& Writer::write(const double &value, const int &precision) {
+    // enough for any double in fixed notation up to 1e300 and 60 decimals
+    char number[384];
+    int length = std::snprintf(number, sizeof(number), "%.*f", precision,
+                               value);
+    if (length < 0)
+        throw Exception("Writer could not format a floating point number");
+    return write(number, std::min<size_t>(length, sizeof(number) - 1));
+}
+
+void Writer::flush() {
+    size_t size = position_ - begin_;
+    position_ = begin_;
+    if (size == 0)
+        return;
+
+    drain(begin_, size);
+    flushed_ += size;
+}
+
+void Writer::writeChunks(const struct iovec *chunks, const size_t &count) {
+    flush();
+    drainChunks(chunks, count);
+    for (size_t i = 0; i < count; ++i)
+        flushed_ += chunks[i].iov_len;
+}
+
+void Writer::drainChunks(const struct iovec *chunks, const size_t &count) {
+    std::vector<struct iovec> left(chunks, chunks + count);
+    size_t first = 0;
+    while (first < left.size()) {
+        if (left[first].iov_len == 0) {
+            ++first;
+            continue;
+        }
+
+        int batch = static_cast<int>(std::min<size_t>(left.size() - first,
+                                                      IOV_MAX));
+        ssize_t done = ::writev(fd_, &left[first], batch);
+        if (done < 0) {
+            if (errno == EINTR)
+                continue;
+            throw Exception("Writer could not write the output");
+        }
+
+        // whatever went out is taken off the front
+        size_t remaining = done;
+        while (first < left.size() && remaining >= left[first].iov_len) {
+            remaining -= left[first].iov_len;
+            ++first;
+        }
+        if (remaining > 0) {
+            left[first].iov_base =
+                static_cast<char*>(left[first].iov_base) + remaining;
+            left[first].iov_len -= remaining;
+        }
+    }
+}
+
+void Writer::drain(const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t done = ::write(fd_, data, size);
+        if (done < 0) {
+            if (errno == EINTR)
+                continue;
+            throw Exception("Writer could not write the output");
+        }
+        data += done;
+        size -= done;
+    }
+}
+
+/**
+ * One call serializers, all of them end with a new line
+ * Graphs are printed with the labels they have (a deferred Index included)
+ */
+
+// "n m" and then each edge as "from to"
+template<class NodeData, class EdgeData>
+void writeEdgeList(Writer &writer,
+                   const Graph<NodeData, EdgeData> &graph,
+                   Boolean::Object header = Boolean::True) {
+    if (header) {
+        int64_t edges = 0;
+        for (auto &edge : graph.edgeRange()) {
+            static_cast<void>(edge);
+            ++edges;
+        }
+        writer << graph.size() << ' ' << edges << '\n';
+    }
+
+    for (auto &edge : graph.edgeRange())
+        writer(graph.label(edge.fromIndex()), graph.label(edge.toIndex()));
+}
+
+// the same with the weight of every edge after it, weights[i] is the weight
+// of the i-th edge of edgeRange() (see attributes.hpp)
+template<class NodeData, class EdgeData, class Weight>
+void writeEdgeList(Writer &writer,
+                   const Graph<NodeData, EdgeData> &graph,
+                   const std::vector<Weight> &weights,
+                   Boolean::Object header = Boolean::True) {
+    if (header)
+        writer << graph.size() << ' ' << weights.size() << '\n';
+
+    auto weight = weights.begin();
+    for (auto &edge : graph.edgeRange()) {
+#ifdef INPUT_GENERATOR_DEBUG
+        if (weight == weights.end())
+            throw Exception("writeEdgeList expects a weight for every edge");
+#endif
+        writer(graph.label(edge.fromIndex()), graph.label(edge.toIndex()),
+               *weight++);
+    }
+}
+
+// the parent of every node in order, for a tree rooted at `root`
+// the root's parent is one less than the smallest index (0 if they start
+// from 1)
+template<class NodeData, class EdgeData>
+void writeParentArray(Writer &writer,
+                      const Graph<NodeData, EdgeData> &graph,
+                      const NodeWrapper<NodeData, EdgeData> &root) {
+    const int64_t first = graph.min();
+    std::vector<int64_t> parent(graph.size(), first - 1);
+    std::vector<bool> seen(graph.size(), false);
+    std::vector<int64_t> queue;
+    queue.reserve(graph.size());
+
+    queue.push_back(root.index());
+    seen[root.index() - first] = true;
+    for (size_t i = 0; i < queue.size(); ++i)
+        for (auto &edge : graph[queue[i]].adjacency()) {
+            int64_t next = edge.toIndex();
+            if (seen[next - first])
+                continue;
+            seen[next - first] = true;
+            parent[next - first] = queue[i];
+            queue.push_back(next);
+        }
+
+    // the labels might not be in index order with a deferred Index
+    std::vector<int64_t> byLabel(graph.size());
+    for (int64_t i = 0; i < graph.size(); ++i)
+        byLabel[graph.label(first + i) - first] =
+            parent[i] == first - 1 ? parent[i] : graph.label(parent[i]);
+
+    for (int64_t i = 0; i < graph.size(); ++i) {
+        if (i > 0)
+            writer.put(' ');
+        writer.write(byLabel[i]);
+    }
+    writer.put('\n');
+}
+
+// one line per node: its degree and then its neighbours in order
+template<class NodeData, class EdgeData>
+void writeAdjacency(Writer &writer, const Graph<NodeData, EdgeData> &graph) {
+    const int64_t first = graph.min();
+    std::vector<int64_t> position(graph.size());
+    for (int64_t i = 0; i < graph.size(); ++i)
+        position[graph.label(first + i) - first] = first + i;
+
+    std::vector<int64_t> neighbours;
+    for (int64_t i = 0; i < graph.size(); ++i) {
+        neighbours.clear();
+        for (auto &edge : graph[position[i]].adjacency())
+            neighbours.push_back(graph.label(edge.toIndex()));
+        std::sort(neighbours.begin(), neighbours.end());
+
+        writer.write(neighbours.size());
+        for (auto &neighbour : neighbours)
+            writer.put(' ').write(neighbour);
+        writer.put('\n');
+    }
+}
+
+// the elements on one line, split by `separator`
+template<class Container>
+void writeVector(Writer &writer,
+                 const Container &data,
+                 const char &separator = ' ') {
+    bool first = true;
+    for (auto &element : data) {
+        if (!first)
+            writer.put(separator);
+        first = false;
+        writer << element;
+    }
+    writer.put('\n');
+}
+
+// one row per line
+template<class Container>
+void writeMatrix(Writer &writer,
+                 const std::vector<Container> &matrix,
+                 const char &separator = ' ') {
+    for (auto &row : matrix)
+        writeVector(writer, row, separator);
+}
+
+void writeString(Writer &writer, const std::string &data) {
+    writer.write(data).put('\n');
+}
+
+}  // namespace inputGenerator
+
+#endif  // INPUT_GENERATOR_WRITER_HPP_